@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "SymbolTable.hpp"
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -20,13 +22,14 @@ namespace pddl::parser
 /// Stored in Term::numeric when the term is a fluent reference rather than a
 /// plain identifier.  The function arguments are stored as resolved names so
 /// that substitution (variable → object) can update them without re-parsing.
+/// Grounding maps each ground reference to a dense solver::FluentId.
 /// *****************************************************************************
 struct FluentRef
 {
     std::string              func; ///< Function name, e.g. "money".
     std::vector<std::string> args; ///< Resolved argument names, e.g. {"alice"}.
 
-    /// Compute the WorldState fluent key (e.g. "money(alice)").
+    /// Text form of the fluent (e.g. "money(alice)"), used for debug printing.
     std::string key() const;
 };
 
@@ -116,88 +119,6 @@ struct DerivedPredicate
     std::vector<Predicate> body; ///< Conjunction of conditions (may contain variables).
 };
 
-// Forward declaration needed by eval_numeric.
-class WorldState;
-
-/// Evaluate a numeric term (literal or fluent reference) against a world state.
-/// Returns the literal value for @c double terms, looks up the fluent for
-/// @c FluentRef terms, and returns @c 0.0 for plain-identifier (monostate) terms.
-double eval_numeric(WorldState const& ws, Term const& t);
-
-/// *****************************************************************************
-/// A set of ground (variable-free) predicates representing the world.
-///
-/// Encapsulates fact storage and provides query/mutation operations.
-/// *****************************************************************************
-class WorldState
-{
-public:
-
-    /// Check whether a ground predicate is currently true.
-    /// @param pred_name  Predicate name to look for.
-    /// @param args       Expected argument names (must match exactly).
-    /// @return True if the fact is present.
-    bool holds(std::string const& pred_name, std::vector<std::string> const& args) const;
-
-    /// Add a predicate to the state (no-op if already present).
-    void add(const Predicate& p);
-
-    /// Remove all matching facts from the state.
-    void remove(std::string const& pred_name, std::vector<std::string> const& args);
-
-    /// Read-only access to the internal fact list.
-    std::vector<Predicate> const& get_facts() const
-    {
-        return m_facts;
-    }
-
-    /// Number of facts currently stored.
-    size_t fact_count() const
-    {
-        return m_facts.size();
-    }
-
-    /// Get a numeric fluent value (returns 0.0 if not set).
-    /// @param key  Fluent key, e.g. "money(alice)".
-    double get_fluent(std::string const& key) const;
-
-    /// Set a numeric fluent value.
-    /// @param key  Fluent key, e.g. "money(alice)".
-    /// @param val  The value to assign.
-    void set_fluent(std::string const& key, double val);
-
-    /// Check whether a fluent exists.
-    bool has_fluent(std::string const& key) const;
-
-    /// Read-only access to all fluents.
-    std::unordered_map<std::string, double> const& get_fluents() const
-    {
-        return m_fluents;
-    }
-
-    /// Equality comparison (needed for planner visited set).
-    bool operator==(WorldState const& other) const;
-
-    /// Evaluate a single predicate (handles boolean facts and numeric comparisons).
-    /// @param p  The predicate to evaluate.
-    /// @return True if the predicate holds in this state.
-    bool evaluates(Predicate const& p) const;
-
-    /// Check whether all goal predicates are satisfied.
-    /// @param goals  Conjunction of goal predicates.
-    /// @return True if all goals are met.
-    bool is_goal_reached(std::vector<Predicate> const& goals) const;
-
-private:
-
-    static std::vector<std::string> to_names(const std::vector<Term>& terms);
-
-private:
-
-    std::vector<Predicate> m_facts;
-    std::unordered_map<std::string, double> m_fluents;
-};
-
 /// *****************************************************************************
 /// A parsed PDDL domain: name, requirements, type hierarchy, predicate
 /// signatures, function declarations, actions, and derived predicates.
@@ -208,10 +129,15 @@ struct Domain
     std::vector<std::string> requirements;   ///< PDDL requirement flags (e.g. ":typing").
     std::vector<TypeDef>     types;          ///< Type hierarchy from @c :types.
     std::vector<std::string> constants;      ///< Domain constants from @c :constants.
+    std::unordered_map<std::string, std::string> constant_types; ///< Declared type of each constant ("" if untyped).
     std::vector<Predicate>   predicates;     ///< Declared predicate signatures.
     std::vector<Predicate>   functions;      ///< Declared numeric function signatures from @c :functions.
     std::vector<Action>      actions;        ///< All action definitions.
     std::vector<DerivedPredicate> derived;   ///< Derived predicate axioms from @c :derived.
+
+    /// Identifier table filled at load time; share it with load_problem so that
+    /// domain and problem symbols get the same IDs.
+    std::shared_ptr<SymbolTable> symbols = std::make_shared<SymbolTable>();
 };
 
 /// *****************************************************************************
@@ -221,10 +147,12 @@ struct Problem
 {
     std::string name;                 ///< Problem name from @c (problem ...).
     std::string domain_name;          ///< Referenced domain name.
-    std::vector<std::string> objects; ///< Declared objects (names only; types stored in Term::type if needed).
-    WorldState init;                  ///< Initial world state.
+    std::vector<std::string> objects; ///< Declared objects, in declaration order.
+    std::unordered_map<std::string, std::string> object_types; ///< Declared type of each object ("" if untyped).
+    std::vector<Predicate> init;      ///< Initial facts and fluent assignments @c (= (f args) value).
     std::vector<Predicate> goal;      ///< Goal as a conjunction of predicates.
     std::string metric;               ///< Serialized metric expression (e.g. "minimize total-cost"). May be empty.
+    std::shared_ptr<SymbolTable> symbols; ///< Identifier table (the domain's one when shared at load time).
 };
 
 } // namespace pddl::parser
@@ -1,179 +1,175 @@
 #include "AStarSolver.hpp"
+#include "ClosedList.hpp"
+#include "SuccessorGenerator.hpp"
 #include <algorithm>
 #include <iostream>
-#include <queue>
-#include <sstream>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace pddl::solver
 {
 
 /// *****************************************************************************
-/// A* Node
+/// Extract the @c name field from each Term into a plain string vector.
+/// Used to look up ground atoms in the AtomTable.
 /// *****************************************************************************
-struct Node
+static std::vector<std::string> term_names(const std::vector<parser::Term>& terms)
 {
-    float estimated_cost; ///< f = g + h (must never overestimate)
-    float real_cost;      ///< g = cost so far
-    parser::WorldState state;
-    std::vector<std::string> plan;
-
-    /// Compare nodes by estimated cost.
-    bool operator>(const Node& o) const
-    {
-        return estimated_cost > o.estimated_cost;
-    }
-};
+    std::vector<std::string> names;
+    names.reserve(terms.size());
+    for (const auto& t : terms)
+        names.push_back(t.name);
+    return names;
+}
 
-/// *****************************************************************************
-/// State hashing with bucketization
-///
-/// Bucketization quantises numeric fluent values before hashing: a fluent with
-/// value @p v is snapped to @c floor(v / bucket_size) * bucket_size.  Two states
-/// whose fluents differ by less than @p bucket_size are therefore treated as
-/// identical, which prevents the search from exploring an exponential number of
-/// nearly-equal numeric states.  The trade-off is that the resulting plan may
-/// not be perfectly optimal.  Set @p bucket_size to 0 for exact (but slower)
-/// hashing.
-///
-/// Returns a @c size_t hash rather than a string to avoid heap allocations on
-/// every A* expansion.  A good 64-bit mixing function makes collisions
-/// statistically negligible for realistic planning problems.
-/// *****************************************************************************
+/// Map a comparison predicate name to its Comparator (false if not a comparison).
+static bool comparator_of(const std::string& name, Comparator& op)
+{
+    if (name == "=")
+        op = Comparator::Eq;
+    else if (name == "<")
+        op = Comparator::Lt;
+    else if (name == "<=")
+        op = Comparator::Le;
+    else if (name == ">")
+        op = Comparator::Gt;
+    else if (name == ">=")
+        op = Comparator::Ge;
+    else
+        return false;
+    return true;
+}
 
-/// *****************************************************************************
-/// Combine @p v into hash @p seed using boost::hash_combine mixing.
-/// *****************************************************************************
-static void hash_combine(size_t& seed, size_t v)
+/// Logical negation of a comparison: @c (not (>= a b)) is @c (< a b).
+static Comparator negate(Comparator op)
 {
-    seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    switch (op)
+    {
+        case Comparator::Eq:
+            return Comparator::Ne;
+        case Comparator::Ne:
+            return Comparator::Eq;
+        case Comparator::Lt:
+            return Comparator::Ge;
+        case Comparator::Le:
+            return Comparator::Gt;
+        case Comparator::Gt:
+            return Comparator::Le;
+        case Comparator::Ge:
+            return Comparator::Lt;
+    }
+    return op;
 }
 
 /// *****************************************************************************
-/// State key for hashing
+/// Resolve a ground numeric term (literal or fluent reference) to an operand.
+/// Plain identifiers evaluate to @c 0.0, like unset fluents.
 /// *****************************************************************************
-static size_t state_key(const parser::WorldState& ws, int bucket_size)
+static NumericOperand ground_operand(const parser::Term& t, AtomTable& atoms)
 {
-    size_t h = 0;
-
-    // Hash numeric fluents in sorted order (determinism requires consistent ordering).
-    std::vector<std::pair<std::string, double>> fluents(ws.get_fluents().begin(), ws.get_fluents().end());
-    std::sort(fluents.begin(), fluents.end());
-    for (const auto& [name, val] : fluents)
+    NumericOperand o;
+    if (const double* d = std::get_if<double>(&t.numeric))
     {
-        const double bucketed =
-            (bucket_size > 0) ? static_cast<double>(static_cast<long long>(val / bucket_size)) : val;
-        hash_combine(h, std::hash<std::string>{}(name));
-        hash_combine(h, std::hash<double>{}(bucketed));
+        o.value = *d;
     }
-
-    // Hash boolean facts in sorted order.
-    std::vector<std::string> fact_keys;
-    fact_keys.reserve(ws.get_facts().size());
-    for (const auto& f : ws.get_facts())
+    else if (const auto* ref = std::get_if<parser::FluentRef>(&t.numeric))
     {
-        std::string s = f.name;
-        for (const auto& a : f.args)
-        {
-            s += ',';
-            s += a.name;
-        }
-        fact_keys.push_back(std::move(s));
+        o.is_fluent = true;
+        o.fluent = atoms.fluent(ref->func, ref->args);
     }
-    std::sort(fact_keys.begin(), fact_keys.end());
-    for (const auto& s : fact_keys)
-        hash_combine(h, std::hash<std::string>{}(s));
-
-    return h;
+    return o;
 }
 
 /// *****************************************************************************
-/// Default heuristic: count unsatisfied goals
+/// Convert a ground (substituted) predicate into an ID-based condition.
+///
+/// Handles the @c not: prefix convention of the parser, numeric comparisons,
+/// and object equality @c (= a b) which compares the symbol IDs of @c a and @c b.
 /// *****************************************************************************
-static float default_heuristic(const parser::WorldState& ws, const std::vector<parser::Predicate>& goals)
+static GroundCondition ground_condition(const parser::Predicate& p, AtomTable& atoms)
 {
-    float count = 0;
-    for (const auto& g : goals)
+    const bool negated = p.name.starts_with("not:");
+    const std::string name = negated ? p.name.substr(4) : p.name;
+
+    GroundCondition c;
+    if (comparator_of(name, c.op) && p.args.size() == 2)
     {
-        if (!ws.evaluates(g))
-            ++count;
+        c.kind = GroundCondition::Kind::Compare;
+        if (negated)
+            c.op = negate(c.op);
+
+        const parser::Term& lhs = p.args[0];
+        const parser::Term& rhs = p.args[1];
+        const bool objects = std::holds_alternative<std::monostate>(lhs.numeric) &&
+                             std::holds_alternative<std::monostate>(rhs.numeric);
+        if (objects)
+        {
+            c.lhs.value = atoms.symbols().intern(lhs.name);
+            c.rhs.value = atoms.symbols().intern(rhs.name);
+        }
+        else
+        {
+            c.lhs = ground_operand(lhs, atoms);
+            c.rhs = ground_operand(rhs, atoms);
+        }
+        return c;
     }
-    return count;
-}
 
-/// *****************************************************************************
-/// Extract the @c name field from each Term into a plain string vector.
-/// Used to call WorldState::remove / holds which accept string argument lists.
-/// *****************************************************************************
-static std::vector<std::string> term_names(const std::vector<parser::Term>& terms)
-{
-    std::vector<std::string> names;
-    names.reserve(terms.size());
-    for (const auto& t : terms)
-        names.push_back(t.name);
-    return names;
+    c.kind = negated ? GroundCondition::Kind::NotFact : GroundCondition::Kind::Fact;
+    c.atom = atoms.atom(name, term_names(p.args));
+    return c;
 }
 
 /// *****************************************************************************
-/// Apply one effect to a world state and return the updated state.
+/// Convert a ground (substituted) effect into an ID-based effect.
+/// @return std::nullopt for numeric effects whose target is not a fluent.
 /// *****************************************************************************
-static parser::WorldState apply_single_effect(parser::WorldState ws, const parser::Effect& eff)
+static std::optional<GroundEffect> ground_effect(const parser::Effect& e, AtomTable& atoms)
 {
-    // Conditional (when ...) effect: recurse only when the guard holds.
-    if (eff.when_condition.has_value())
-    {
-        if (ws.evaluates(*eff.when_condition))
-        {
-            parser::Effect consequent;
-            consequent.is_negated = eff.is_negated;
-            consequent.numeric_op = eff.numeric_op; ///< Must propagate so numeric when-effects work.
-            consequent.predicate = eff.predicate;
-            return apply_single_effect(std::move(ws), consequent);
-        }
-        return ws;
-    }
+    const parser::Predicate& p = e.predicate;
 
-    const parser::Predicate& p = eff.predicate;
+    GroundEffect ge;
+    if (e.when_condition.has_value())
+        ge.when = ground_condition(*e.when_condition, atoms);
 
-    if (eff.is_negated)
+    if (e.is_negated)
     {
-        ws.remove(p.name, term_names(p.args));
-        return ws;
+        ge.kind = GroundEffect::Kind::Delete;
+        ge.atom = atoms.atom(p.name, term_names(p.args));
     }
-
-    // Numeric mutation: increase / decrease / assign a fluent.
-    if (eff.numeric_op != parser::NumericOp::None && p.args.size() >= 2)
+    else if (e.numeric_op != parser::NumericOp::None)
     {
-        const auto* ref = std::get_if<parser::FluentRef>(&p.args[0].numeric);
-        if (ref)
-        {
-            const std::string key = ref->key();
-            const double delta = parser::eval_numeric(ws, p.args[1]);
-            switch (eff.numeric_op)
-            {
-                case parser::NumericOp::Increase:
-                    ws.set_fluent(key, ws.get_fluent(key) + delta);
-                    break;
-                case parser::NumericOp::Decrease:
-                    ws.set_fluent(key, ws.get_fluent(key) - delta);
-                    break;
-                case parser::NumericOp::Assign:
-                    ws.set_fluent(key, delta);
-                    break;
-                default:
-                    break;
-            }
-        }
-        return ws;
+        const auto* ref = (p.args.size() >= 2) ? std::get_if<parser::FluentRef>(&p.args[0].numeric) : nullptr;
+        if (!ref)
+            return std::nullopt;
+        ge.kind = GroundEffect::Kind::Numeric;
+        ge.op = e.numeric_op;
+        ge.fluent = atoms.fluent(ref->func, ref->args);
+        ge.value = ground_operand(p.args[1], atoms);
+    }
+    else
+    {
+        ge.kind = GroundEffect::Kind::Add;
+        ge.atom = atoms.atom(p.name, term_names(p.args));
     }
+    return ge;
+}
 
-    // Boolean add effect.
-    parser::Predicate fact;
-    fact.name = p.name;
-    for (const auto& arg : p.args)
-        fact.args.push_back({ arg.name, /*type=*/"", /*is_variable=*/false });
-    ws.add(fact);
-    return ws;
+/// *****************************************************************************
+/// Variable → object binding of one instantiation, in parameter order.
+/// Schemas have few parameters, so a flat list beats a hash map; the views
+/// point into the schema parameters and the candidate object lists.
+/// *****************************************************************************
+using Substitution = std::vector<std::pair<std::string_view, std::string_view>>;
+
+/// Object bound to @p var in @p subst, or nullptr if @p var is not a parameter.
+static const std::string_view* bound_object(const Substitution& subst, std::string_view var)
+{
+    for (const auto& [v, obj] : subst)
+        if (v == var)
+            return &obj;
+    return nullptr;
 }
 
 /// *****************************************************************************
@@ -181,7 +177,7 @@ static parser::WorldState apply_single_effect(parser::WorldState ws, const parse
 /// object in @p s.  The word-boundary check prevents partial matches (e.g.
 /// @c ?agent must not match inside @c ?agent-type).
 /// *****************************************************************************
-static std::string substitute(const std::string& s, const std::unordered_map<std::string, std::string>& subst)
+static std::string substitute(const std::string& s, const Substitution& subst)
 {
     std::string result = s;
     for (const auto& [var, obj] : subst)
@@ -208,11 +204,18 @@ static std::string substitute(const std::string& s, const std::unordered_map<std
 
 /// *****************************************************************************
 /// Substitute variables in a single Term, including inside FluentRef::args.
+/// Plain variables are looked up directly; only serialized sub-expressions
+/// still containing a @c ? go through the textual substitute().
 /// *****************************************************************************
-static parser::Term substitute_term(const parser::Term& t, const std::unordered_map<std::string, std::string>& subst)
+static parser::Term substitute_term(const parser::Term& t, const Substitution& subst)
 {
     parser::Term result;
-    result.name = substitute(t.name, subst);
+    if (const std::string_view* obj = t.is_variable ? bound_object(subst, t.name) : nullptr)
+        result.name = *obj;
+    else if (t.name.find('?') != std::string::npos)
+        result.name = substitute(t.name, subst);
+    else
+        result.name = t.name;
     result.type = t.type;
     result.is_variable = false;
 
@@ -220,10 +223,11 @@ static parser::Term substitute_term(const parser::Term& t, const std::unordered_
     {
         parser::FluentRef new_ref;
         new_ref.func = ref->func;
+        new_ref.args.reserve(ref->args.size());
         for (const auto& a : ref->args)
         {
-            auto it = subst.find(a);
-            new_ref.args.push_back(it != subst.end() ? it->second : a);
+            const std::string_view* obj = bound_object(subst, a);
+            new_ref.args.emplace_back(obj ? *obj : std::string_view(a));
         }
         result.numeric = std::move(new_ref);
     }
@@ -237,12 +241,12 @@ static parser::Term substitute_term(const parser::Term& t, const std::unordered_
 /// *****************************************************************************
 /// Substitute variables in all arguments of a Predicate.
 /// *****************************************************************************
-static parser::Predicate substitute_predicate(const parser::Predicate& p,
-                                              const std::unordered_map<std::string, std::string>& subst)
+static parser::Predicate substitute_predicate(const parser::Predicate& p, const Substitution& subst)
 {
     parser::Predicate result;
     result.name = p.name;
     result.line = p.line;
+    result.args.reserve(p.args.size());
     for (const auto& arg : p.args)
         result.args.push_back(substitute_term(arg, subst));
     return result;
@@ -251,8 +255,7 @@ static parser::Predicate substitute_predicate(const parser::Predicate& p,
 /// *****************************************************************************
 /// Substitute variables in an Effect (predicate, optional when-condition, numeric_op is unchanged).
 /// *****************************************************************************
-static parser::Effect substitute_effect(const parser::Effect& e,
-                                        const std::unordered_map<std::string, std::string>& subst)
+static parser::Effect substitute_effect(const parser::Effect& e, const Substitution& subst)
 {
     parser::Effect result;
     result.is_negated = e.is_negated;
@@ -264,50 +267,265 @@ static parser::Effect substitute_effect(const parser::Effect& e,
 }
 
 /// *****************************************************************************
-/// Build every possible variable→object mapping for @p params over @p objects.
-/// Returns the Cartesian product: one map per combination.
+/// Call @p visit for every binding of @p params where parameter @c i ranges
+/// over @p candidates[i] and the first parameter is fixed to
+/// @p candidates[0][first].  Bindings are visited in lexicographic order of
+/// the candidate indices (last parameter varying fastest); a schema without
+/// parameters yields a single empty binding.
+/// *****************************************************************************
+template <typename Visit>
+static void for_each_substitution(const std::vector<parser::Term>& params,
+                                  const std::vector<std::vector<std::string>>& candidates,
+                                  size_t first,
+                                  Visit&& visit)
+{
+    Substitution subst;
+    if (params.empty())
+    {
+        visit(subst);
+        return;
+    }
+    for (size_t i = 1; i < params.size(); ++i)
+        if (candidates[i].empty())
+            return;
+
+    // Odometer over the candidate indices of parameters 1..n-1.
+    std::vector<size_t> index(params.size(), 0);
+    index[0] = first;
+    subst.reserve(params.size());
+    for (size_t i = 0; i < params.size(); ++i)
+        subst.emplace_back(params[i].name, candidates[i][index[i]]);
+
+    for (;;)
+    {
+        visit(subst);
+        size_t i = params.size() - 1;
+        for (; i > 0; --i)
+        {
+            if (++index[i] < candidates[i].size())
+                break;
+            index[i] = 0;
+            subst[i].second = candidates[i][0];
+        }
+        if (i == 0)
+            return;
+        subst[i].second = candidates[i][index[i]];
+    }
+}
+
+/// *****************************************************************************
+/// Check whether @p type is @p ancestor or one of its subtypes in the domain
+/// @c :types hierarchy.  Everything is an @c object; untyped names (empty
+/// type) are accepted everywhere since nothing proves them incompatible.
+/// *****************************************************************************
+static bool is_subtype(const parser::Domain& d, std::string type, const std::string& ancestor)
+{
+    if (ancestor.empty() || ancestor == "object" || type.empty())
+        return true;
+    // Bounded walk up the hierarchy (guards against cyclic declarations).
+    for (size_t depth = 0; depth <= d.types.size() && !type.empty(); ++depth)
+    {
+        if (type == ancestor)
+            return true;
+        auto it = std::find_if(d.types.begin(), d.types.end(), [&](const parser::TypeDef& t) { return t.name == type; });
+        if (it == d.types.end())
+            return false;
+        type = it->parent;
+    }
+    return false;
+}
+
+/// *****************************************************************************
+/// For each parameter, the problem objects and domain constants whose declared
+/// type matches the parameter type.
 /// *****************************************************************************
-static std::vector<std::unordered_map<std::string, std::string>>
-build_substitutions(const std::vector<parser::Term>& params, const std::vector<std::string>& objects)
+static std::vector<std::vector<std::string>>
+typed_candidates(const std::vector<parser::Term>& params, const parser::Domain& d, const parser::Problem& p)
 {
-    std::vector<std::unordered_map<std::string, std::string>> substitutions;
-    substitutions.push_back({});
+    auto type_of = [](const std::unordered_map<std::string, std::string>& types, const std::string& name)
+    {
+        auto it = types.find(name);
+        return (it != types.end()) ? it->second : std::string();
+    };
 
+    std::vector<std::vector<std::string>> candidates;
+    candidates.reserve(params.size());
     for (const auto& param : params)
     {
-        std::vector<std::unordered_map<std::string, std::string>> new_subs;
-        for (const auto& subst : substitutions)
+        std::vector<std::string> objs;
+        for (const auto& o : p.objects)
+            if (is_subtype(d, type_of(p.object_types, o), param.type))
+                objs.push_back(o);
+        for (const auto& c : d.constants)
+            if (is_subtype(d, type_of(d.constant_types, c), param.type))
+                objs.push_back(c);
+        candidates.push_back(std::move(objs));
+    }
+    return candidates;
+}
+
+/// *****************************************************************************
+/// What never changes during search, used to prune grounding.
+///
+/// A predicate is static when no action effect and no derived predicate head
+/// mentions it; a function is static when no numeric effect targets it.  The
+/// truth of static atoms and the value of static fluents is read from the
+/// initial state.
+/// *****************************************************************************
+struct StaticInfo
+{
+    std::unordered_set<std::string> modified_predicates; ///< Predicates changed by effects or derived.
+    std::unordered_set<std::string> modified_functions;  ///< Functions changed by numeric effects.
+    WorldState init;                                     ///< Initial state of the problem.
+};
+
+/// *****************************************************************************
+/// Collect the non-static predicates and functions of @p d.
+/// *****************************************************************************
+static StaticInfo analyse_statics(const parser::Domain& d, const parser::Problem& p, AtomTable& atoms)
+{
+    StaticInfo info;
+    for (const auto& action : d.actions)
+    {
+        for (const auto& eff : action.effects)
         {
-            for (const auto& obj : objects)
-            {
-                auto ns = subst;
-                ns[param.name] = obj;
-                new_subs.push_back(std::move(ns));
-            }
+            if (eff.numeric_op == parser::NumericOp::None)
+                info.modified_predicates.insert(eff.predicate.name);
+            else if (!eff.predicate.args.empty())
+                if (const auto* ref = std::get_if<parser::FluentRef>(&eff.predicate.args[0].numeric))
+                    info.modified_functions.insert(ref->func);
+        }
+    }
+    for (const auto& dp : d.derived)
+        info.modified_predicates.insert(dp.head.name);
+    info.init = AStarSolver::build_initial_state(p, atoms);
+    return info;
+}
+
+/// *****************************************************************************
+/// Truth value of a ground (substituted) condition when it only depends on
+/// static atoms, static fluents and constants.
+/// @return std::nullopt when the condition may change during search.
+/// *****************************************************************************
+static std::optional<bool> static_truth(const parser::Predicate& p, const StaticInfo& statics, const AtomTable& atoms)
+{
+    const bool negated = p.name.starts_with("not:");
+    const std::string name = negated ? p.name.substr(4) : p.name;
+
+    Comparator op;
+    if (comparator_of(name, op) && p.args.size() == 2)
+    {
+        if (negated)
+            op = negate(op);
+
+        const parser::Term& lhs = p.args[0];
+        const parser::Term& rhs = p.args[1];
+        if (std::holds_alternative<std::monostate>(lhs.numeric) &&
+            std::holds_alternative<std::monostate>(rhs.numeric))
+        {
+            // Object equality (= ?x ?y) is known as soon as both sides are bound.
+            if (op == Comparator::Eq || op == Comparator::Ne)
+                return (lhs.name == rhs.name) == (op == Comparator::Eq);
+            return std::nullopt;
+        }
+
+        auto value = [&](const parser::Term& t) -> std::optional<double>
+        {
+            const auto* ref = std::get_if<parser::FluentRef>(&t.numeric);
+            if (!ref)
+                return std::holds_alternative<double>(t.numeric) ? std::get<double>(t.numeric) : 0.0;
+            if (statics.modified_functions.contains(ref->func))
+                return std::nullopt;
+            auto id = atoms.find_fluent(ref->func, ref->args);
+            return id ? statics.init.get_fluent(*id) : 0.0;
+        };
+        const auto l = value(lhs);
+        const auto r = value(rhs);
+        if (!l || !r)
+            return std::nullopt;
+        return compare(op, *l, *r);
+    }
+
+    if (statics.modified_predicates.contains(name))
+        return std::nullopt;
+    const auto id = atoms.find_atom(name, term_names(p.args));
+    const bool holds = id && statics.init.holds(*id);
+    return negated ? !holds : holds;
+}
+
+/// *****************************************************************************
+/// Substitute the conditions @p conds under @p subst into @p out, dropping the
+/// statically true ones.  Only reads @p atoms, so it is safe to call
+/// concurrently while no other thread interns.
+/// @return False if some condition is statically false (the instance can never fire).
+/// *****************************************************************************
+static bool resolve_conditions(const std::vector<parser::Predicate>& conds,
+                               const Substitution& subst,
+                               const StaticInfo& statics,
+                               const AtomTable& atoms,
+                               std::vector<parser::Predicate>& out)
+{
+    for (const auto& cond : conds)
+    {
+        parser::Predicate ground = substitute_predicate(cond, subst);
+        if (auto truth = static_truth(ground, statics, atoms))
+        {
+            if (!*truth)
+                return false;
+            continue;
         }
-        substitutions = std::move(new_subs);
+        out.push_back(std::move(ground));
+    }
+    return true;
+}
+
+/// *****************************************************************************
+/// Unit of parallel grounding: one schema with its first parameter bound to
+/// one candidate object (or the whole schema when it has no parameter).
+/// *****************************************************************************
+struct GroundingTask
+{
+    size_t schema; ///< Index of the action or derived schema.
+    size_t first;  ///< Candidate index of the first parameter.
+};
+
+/// *****************************************************************************
+/// Split the schemas into grounding tasks, in the sequential enumeration order.
+/// @p candidates[k] holds the typed candidates of each parameter of schema @c k.
+/// *****************************************************************************
+static std::vector<GroundingTask>
+make_grounding_tasks(const std::vector<std::vector<std::vector<std::string>>>& candidates)
+{
+    std::vector<GroundingTask> tasks;
+    for (size_t k = 0; k < candidates.size(); ++k)
+    {
+        if (candidates[k].empty())
+            tasks.push_back({k, 0});
+        else
+            for (size_t first = 0; first < candidates[k][0].size(); ++first)
+                tasks.push_back({k, first});
     }
-    return substitutions;
+    return tasks;
 }
 
 /// *****************************************************************************
 /// Build the initial WorldState from parsed problem data.
 /// *****************************************************************************
-parser::WorldState AStarSolver::build_initial_state(const parser::Problem& p)
+WorldState AStarSolver::build_initial_state(const parser::Problem& p, AtomTable& atoms)
 {
-    parser::WorldState ws;
+    WorldState ws(atoms.atom_count(), atoms.fluent_count());
 
-    for (const auto& fact : p.init.get_facts())
+    for (const auto& fact : p.init)
     {
         if (fact.name == "=" && fact.args.size() == 2)
         {
             const auto* ref = std::get_if<parser::FluentRef>(&fact.args[0].numeric);
             if (ref)
-                ws.set_fluent(ref->key(), parser::eval_numeric(ws, fact.args[1]));
+                ws.set_fluent(atoms.fluent(ref->func, ref->args), ws.eval(ground_operand(fact.args[1], atoms)));
         }
         else
         {
-            ws.add(fact);
+            ws.add(atoms.atom(fact.name, term_names(fact.args)));
         }
     }
 
@@ -316,181 +534,302 @@ parser::WorldState AStarSolver::build_initial_state(const parser::Problem& p)
 
 /// *****************************************************************************
 /// Instantiate all domain actions with concrete objects from the problem.
+///
+/// Grounding runs in three phases so that the output order (and thus the
+/// plans found) does not depend on thread scheduling:
+///  1. in parallel, each GroundingTask substitutes its bindings and filters
+///     them on static preconditions, only reading @p atoms;
+///  2. sequentially, in task order, the surviving instances are interned;
+///  3. in parallel, each ground action is compiled to bytecode.
 /// @return One GroundAction per valid (action, object-combination).
 /// *****************************************************************************
-std::vector<GroundAction> AStarSolver::instantiate_actions(const parser::Domain& d, const parser::Problem& p)
+std::vector<GroundAction> AStarSolver::instantiate_actions(const parser::Domain& d,
+                                                           const parser::Problem& p,
+                                                           AtomTable& atoms,
+                                                           ThreadPool& pool)
 {
-    // Gather all objects: problem objects + domain constants
-    std::vector<std::string> all_objects = p.objects;
-    for (const auto& c : d.constants)
-        all_objects.push_back(c);
-
-    std::vector<GroundAction> actions;
+    const StaticInfo statics = analyse_statics(d, p, atoms);
 
+    std::vector<std::vector<std::vector<std::string>>> candidates;
     for (const auto& action : d.actions)
+        candidates.push_back(typed_candidates(action.parameters, d, p));
+    const auto tasks = make_grounding_tasks(candidates);
+
+    // Phase 1: substituted (but not yet interned) instances of each task.
+    struct Instance
     {
-        // No parameters: instantiate a plain action without grounding.
-        if (action.parameters.empty())
+        std::string name;
+        std::vector<parser::Predicate> preconditions;
+        std::vector<parser::Effect> effects;
+    };
+    std::vector<std::vector<Instance>> instances(tasks.size());
+    pool.parallel_for(tasks.size(), [&](size_t t)
+    {
+        const parser::Action& action = d.actions[tasks[t].schema];
+        for_each_substitution(action.parameters, candidates[tasks[t].schema], tasks[t].first,
+                              [&](const Substitution& subst)
         {
-            GroundAction ga;
-            ga.name = action.name;
-            ga.cost = action.cost;
-            ga.preconditions = action.preconditions;
-            ga.effects = action.effects;
-            actions.push_back(ga);
-            continue;
-        }
+            Instance inst;
 
-        // Ground the action by substituting each parameter with all possible objects.
-        for (const auto& subst : build_substitutions(action.parameters, all_objects))
-        {
-            GroundAction ga;
+            // Preconditions first: skip instances whose static preconditions are false.
+            if (!resolve_conditions(action.preconditions, subst, statics, atoms, inst.preconditions))
+                return;
 
-            std::ostringstream name_ss;
-            name_ss << action.name << "(";
-            bool first = true;
-            for (const auto& param : action.parameters)
+            inst.name = action.name;
+            if (!action.parameters.empty())
             {
-                if (!first)
-                    name_ss << ",";
-                name_ss << subst.at(param.name);
-                first = false;
+                inst.name += "(";
+                for (size_t i = 0; i < subst.size(); ++i)
+                {
+                    if (i > 0)
+                        inst.name += ",";
+                    inst.name += subst[i].second;
+                }
+                inst.name += ")";
             }
-            name_ss << ")";
-            ga.name = name_ss.str();
-
-            ga.cost = action.cost;
-
-            for (const auto& prec : action.preconditions)
-                ga.preconditions.push_back(substitute_predicate(prec, subst));
 
+            inst.effects.reserve(action.effects.size());
             for (const auto& eff : action.effects)
-                ga.effects.push_back(substitute_effect(eff, subst));
+                inst.effects.push_back(substitute_effect(eff, subst));
+            instances[t].push_back(std::move(inst));
+        });
+    });
 
-            actions.push_back(ga);
+    // Phase 2: intern atoms and fluents in the sequential order.
+    std::vector<GroundAction> actions;
+    for (size_t t = 0; t < tasks.size(); ++t)
+    {
+        for (auto& inst : instances[t])
+        {
+            GroundAction ga;
+            ga.name = std::move(inst.name);
+            ga.cost = d.actions[tasks[t].schema].cost;
+            for (const auto& cond : inst.preconditions)
+                ga.preconditions.push_back(ground_condition(cond, atoms));
+            for (const auto& eff : inst.effects)
+            {
+                if (auto ge = ground_effect(eff, atoms))
+                    ga.effects.push_back(std::move(*ge));
+            }
+            actions.push_back(std::move(ga));
         }
+        instances[t] = {};
     }
 
+    // Phase 3: compile.
+    pool.parallel_for(actions.size(), [&](size_t i) { actions[i].compile(); });
+
     return actions;
 }
 
 /// *****************************************************************************
 /// Instantiate all derived predicates with concrete objects.
+/// Same phases as instantiate_actions (without compilation).
 /// @return One GroundDerivedPredicate per valid (derived, object-combination).
 /// *****************************************************************************
-std::vector<GroundDerivedPredicate> AStarSolver::instantiate_derived(const parser::Domain& d, const parser::Problem& p)
+std::vector<GroundDerivedPredicate> AStarSolver::instantiate_derived(const parser::Domain& d,
+                                                                     const parser::Problem& p,
+                                                                     AtomTable& atoms,
+                                                                     ThreadPool& pool)
 {
-    std::vector<std::string> all_objects = p.objects;
-    for (const auto& c : d.constants)
-        all_objects.push_back(c);
-
-    std::vector<GroundDerivedPredicate> result;
+    const StaticInfo statics = analyse_statics(d, p, atoms);
 
-    for (const auto& dp : d.derived)
+    // Collect variable parameters from each head predicate
+    std::vector<std::vector<parser::Term>> params(d.derived.size());
+    std::vector<std::vector<std::vector<std::string>>> candidates;
+    for (size_t k = 0; k < d.derived.size(); ++k)
     {
-        // Collect variable parameters from the head predicate
-        std::vector<parser::Term> params;
-        for (const auto& arg : dp.head.args)
+        for (const auto& arg : d.derived[k].head.args)
             if (arg.is_variable)
-                params.push_back(arg);
+                params[k].push_back(arg);
+        candidates.push_back(typed_candidates(params[k], d, p));
+    }
+    const auto tasks = make_grounding_tasks(candidates);
 
-        if (params.empty())
+    struct Instance
+    {
+        parser::Predicate head;
+        std::vector<parser::Predicate> conditions;
+    };
+    std::vector<std::vector<Instance>> instances(tasks.size());
+    pool.parallel_for(tasks.size(), [&](size_t t)
+    {
+        const parser::DerivedPredicate& dp = d.derived[tasks[t].schema];
+        for_each_substitution(params[tasks[t].schema], candidates[tasks[t].schema], tasks[t].first,
+                              [&](const Substitution& subst)
         {
-            GroundDerivedPredicate gdp;
-            gdp.head = dp.head;
-            gdp.conditions = dp.body;
-            result.push_back(std::move(gdp));
-            continue;
-        }
+            Instance inst;
+            if (!resolve_conditions(dp.body, subst, statics, atoms, inst.conditions))
+                return;
+            inst.head = substitute_predicate(dp.head, subst);
+            instances[t].push_back(std::move(inst));
+        });
+    });
 
-        for (const auto& subst : build_substitutions(params, all_objects))
+    std::vector<GroundDerivedPredicate> result;
+    for (auto& task_instances : instances)
+    {
+        for (const auto& inst : task_instances)
         {
             GroundDerivedPredicate gdp;
-            gdp.head = substitute_predicate(dp.head, subst);
-            for (const auto& cond : dp.body)
-                gdp.conditions.push_back(substitute_predicate(cond, subst));
+            for (const auto& cond : inst.conditions)
+                gdp.conditions.push_back(ground_condition(cond, atoms));
+            gdp.head = atoms.atom(inst.head.name, term_names(inst.head.args));
             result.push_back(std::move(gdp));
         }
+        task_instances = {};
     }
 
     return result;
 }
 
 /// *****************************************************************************
-/// Expand derived predicates to a fixed point.
-/// Called after build_initial_state and after each apply_action.
-/// *****************************************************************************
-parser::WorldState AStarSolver::expand_derived(parser::WorldState ws,
-                                               const std::vector<GroundDerivedPredicate>& derived)
+/// Remove actions and derived predicates that can never fire.
+///
+/// Delete-relaxed reachability: starting from the true atoms of @p initial,
+/// a unit (action or derived predicate) fires once all its positive fact
+/// conditions are reached, and then reaches its add effects (conditional or
+/// not) or its head.  Negative and numeric conditions are assumed satisfiable,
+/// so the result over-approximates what search can reach.  Each unit keeps a
+/// counter of unreached conditions, so the fixpoint is linear in the task size.
+/// *****************************************************************************
+void AStarSolver::prune_unreachable(const WorldState& initial,
+                                    std::vector<GroundAction>& actions,
+                                    std::vector<GroundDerivedPredicate>& derived)
 {
-    if (derived.empty())
-        return ws;
-
-    // Fixed-point iteration: keep updating until no change occurs
-    bool changed = true;
-    while (changed)
+    const size_t units = actions.size() + derived.size();
+    auto conditions_of = [&](size_t u) -> const std::vector<GroundCondition>&
+    { return (u < actions.size()) ? actions[u].preconditions : derived[u - actions.size()].conditions; };
+
+    // Watch lists: for each atom, the units having it as a positive condition.
+    std::vector<std::vector<size_t>> watchers;
+    std::vector<size_t> missing(units, 0);
+    for (size_t u = 0; u < units; ++u)
     {
-        changed = false;
-        for (const auto& gdp : derived)
+        for (const auto& c : conditions_of(u))
         {
-            // Check whether all conditions hold
-            bool holds = true;
-            for (const auto& cond : gdp.conditions)
-            {
-                if (!ws.evaluates(cond))
-                {
-                    holds = false;
-                    break;
-                }
-            }
-
-            std::vector<std::string> head_args;
-            for (const auto& a : gdp.head.args)
-                head_args.push_back(a.name);
+            if (c.kind != GroundCondition::Kind::Fact)
+                continue;
+            if (c.atom >= watchers.size())
+                watchers.resize(c.atom + 1);
+            watchers[c.atom].push_back(u);
+            ++missing[u];
+        }
+    }
 
-            const bool currently_present = ws.holds(gdp.head.name, head_args);
+    std::vector<bool> reached;
+    std::vector<AtomId> queue;
+    auto reach = [&](AtomId atom)
+    {
+        if (atom >= reached.size())
+            reached.resize(atom + 1, false);
+        if (!reached[atom])
+        {
+            reached[atom] = true;
+            queue.push_back(atom);
+        }
+    };
 
-            if (holds && !currently_present)
-            {
-                ws.add(gdp.head);
-                changed = true;
-            }
-            else if (!holds && currently_present)
-            {
-                ws.remove(gdp.head.name, head_args);
-                changed = true;
-            }
+    std::vector<bool> fired(units, false);
+    auto fire = [&](size_t u)
+    {
+        fired[u] = true;
+        if (u >= actions.size())
+        {
+            reach(derived[u - actions.size()].head);
+            return;
         }
+        for (const auto& eff : actions[u].effects)
+            if (eff.kind == GroundEffect::Kind::Add)
+                reach(eff.atom);
+    };
+
+    for (auto atom : initial.get_facts())
+        reach(atom);
+    for (size_t u = 0; u < units; ++u)
+        if (missing[u] == 0)
+            fire(u);
+
+    while (!queue.empty())
+    {
+        const AtomId atom = queue.back();
+        queue.pop_back();
+        if (atom >= watchers.size())
+            continue;
+        for (auto u : watchers[atom])
+            if (--missing[u] == 0)
+                fire(u);
     }
+
+    // Keep the fired units, in order; derived predicates follow the actions in unit numbering.
+    auto compact = [&](auto& list, size_t first_unit)
+    {
+        size_t out = 0;
+        for (size_t k = 0; k < list.size(); ++k)
+        {
+            if (!fired[first_unit + k])
+                continue;
+            if (out != k)
+                list[out] = std::move(list[k]);
+            ++out;
+        }
+        list.erase(list.begin() + static_cast<std::ptrdiff_t>(out), list.end());
+    };
+    const size_t action_count = actions.size();
+    compact(actions, 0);
+    compact(derived, action_count);
+}
+
+/// *****************************************************************************
+/// Ground the problem goal.
+/// *****************************************************************************
+std::vector<GroundCondition> AStarSolver::ground_goals(const parser::Problem& p, AtomTable& atoms)
+{
+    std::vector<GroundCondition> goals;
+    goals.reserve(p.goal.size());
+    for (const auto& g : p.goal)
+        goals.push_back(ground_condition(g, atoms));
+    return goals;
+}
+
+/// *****************************************************************************
+/// Expand derived predicates to a fixed point.
+/// Called after build_initial_state and after each apply_action.
+/// *****************************************************************************
+WorldState AStarSolver::expand_derived(WorldState ws, const std::vector<GroundDerivedPredicate>& derived)
+{
+    if (!derived.empty())
+        DerivedEvaluator(derived).evaluate(ws);
     return ws;
 }
 
 /// *****************************************************************************
 /// Check if all preconditions of an action hold in the given state.
 /// *****************************************************************************
-bool AStarSolver::is_applicable(const GroundAction& action, const parser::WorldState& ws)
+bool AStarSolver::is_applicable(const GroundAction& action, const WorldState& ws)
 {
-    for (const auto& p : action.preconditions)
-    {
-        if (!ws.evaluates(p))
-            return false;
-    }
-    return true;
+    return check(action.precondition_code, ws);
 }
 
 /// *****************************************************************************
 /// Apply all effects of an action and return the resulting state.
 /// Automatically runs expand_derived if @p derived is non-empty.
 /// *****************************************************************************
-parser::WorldState AStarSolver::apply_action(const GroundAction& action,
-                                             parser::WorldState ws,
-                                             const std::vector<GroundDerivedPredicate>& derived)
+WorldState AStarSolver::apply_action(const GroundAction& action,
+                                     WorldState ws,
+                                     const std::vector<GroundDerivedPredicate>& derived)
 {
-    for (const auto& eff : action.effects)
-        ws = apply_single_effect(ws, eff);
+    execute(action.effect_code, ws);
     return expand_derived(std::move(ws), derived);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+WorldState AStarSolver::apply_action(const GroundAction& action, WorldState ws, DerivedEvaluator& derived)
+{
+    derived.apply(action, ws);
+    return ws;
+}
+
 /// *****************************************************************************
 /// ISolver::solve implementation
 /// *****************************************************************************
@@ -502,67 +841,183 @@ PlanResult AStarSolver::solve(const SolverContext& ctx)
     const auto& derived = ctx.derived;
     const auto& cfg = m_config;
 
-    auto h = cfg.heuristic ? cfg.heuristic : [](const parser::WorldState& ws, const std::vector<parser::Predicate>& g)
-    { return default_heuristic(ws, g); };
-
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
-    std::unordered_map<size_t, float> best_cost; ///< Maps state hash → best g-cost seen so far.
+    std::unique_ptr<IHeuristic> builtin = cfg.heuristic ? nullptr : make_heuristic(cfg.heuristic_kind, ctx);
+    auto h = [&](const WorldState& ws) { return builtin ? builtin->evaluate(ws) : cfg.heuristic(ws, goals); };
+
+    OpenList open(cfg.open_list, cfg.tie_breaking, cfg.insertion_order);
+    std::vector<SearchNode> arena; ///< Parent links of every generated node.
+
+    // Maps each visited state to the best g-cost seen so far (exact, collision-safe).
+    ClosedList best_cost(std::max(ctx.atoms.atom_count(), initial.get_words().size() * WorldState::WORD_BITS),
+                         std::max(ctx.atoms.fluent_count(), initial.get_fluents().size()),
+                         cfg.fluent_bucket_size);
+
+    // Only the candidates returned by the generator are checked for applicability.
+    const SuccessorGenerator successors(actions);
+    DerivedEvaluator axioms(derived);
+    std::vector<std::uint32_t> candidates;
+
+    // Parallel expansion: one heuristic and derived evaluator per lane (the
+    // pool workers and the calling thread), each lane taking a fixed slice of
+    // the (node, action) pairs of the batch.
+    ThreadPool* pool = cfg.expansion_pool;
+    const size_t lanes = pool ? pool->size() + 1 : 0;
+    std::vector<std::unique_ptr<IHeuristic>> lane_heuristics;
+    std::vector<DerivedEvaluator> lane_axioms(lanes, axioms);
+    for (size_t l = 0; l < lanes; ++l)
+        lane_heuristics.push_back(cfg.heuristic ? nullptr : make_heuristic(cfg.heuristic_kind, ctx));
+
+    /// Successor computed by a lane, merged serially.
+    struct Generated
+    {
+        WorldState state;
+        float h = DEAD_END;
+        bool applicable = false;
+    };
+    std::vector<Node> batch;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> work; ///< (batch index, action) pairs.
+    std::vector<Generated> generated;
+
+    // Open the successor of @p parent by action @p a, at cost @p ng and estimate @p hn.
+    auto push_successor = [&](const Node& parent, std::uint32_t a, WorldState&& new_state, float ng, float hn)
+    {
+        Node next;
+        next.real_cost = ng;
+        next.estimated_cost = ng + cfg.weight * hn;
+        next.heuristic = hn;
+        next.state = std::move(new_state);
+        next.record = arena.size();
+        arena.push_back({ parent.record, a });
+        open.push(std::move(next));
+    };
+
+    arena.push_back({ NO_PARENT, 0 });
 
     Node start;
     start.real_cost = 0;
-    start.estimated_cost = h(initial, goals);
+    start.heuristic = h(initial);
+    start.estimated_cost = cfg.weight * start.heuristic;
     start.state = initial;
-    open.push(start);
+    start.state.set_hash_bucket(cfg.fluent_bucket_size); // Successors inherit the bucket size.
+    start.record = 0;
+    if (start.heuristic != DEAD_END)
+        open.push(std::move(start));
 
     size_t iterations = 0;
+    const size_t batch_size = pool ? std::max<size_t>(cfg.expansion_batch, 1) : 1;
+    StopCondition limits(ctx, cfg.max_iterations);
+    ProgressReporter progress(ctx);
 
-    while (!open.empty() && iterations < cfg.max_iterations)
+    while (!open.empty() && !limits(iterations))
     {
-        ++iterations;
-        Node current = open.top();
-        open.pop();
-
-        if (current.state.is_goal_reached(goals))
+        // Pop the nodes to expand.  A goal is only accepted as the best open
+        // node: one popped behind other nodes of the batch goes back.
+        batch.clear();
+        while (!open.empty() && batch.size() < batch_size && iterations < cfg.max_iterations)
         {
-            if (cfg.verbose)
-                std::cerr << "[astar] Goal reached after " << iterations << " iterations\n";
-            return { true, current.plan, current.state, iterations };
+            Node current = open.pop();
+            const bool goal = current.state.is_goal_reached(goals);
+            if (goal && !batch.empty())
+            {
+                open.push(std::move(current));
+                break;
+            }
+            ++iterations;
+
+            if (goal)
+            {
+                if (cfg.verbose)
+                    std::cerr << "[astar] Goal reached after " << iterations << " iterations\n";
+                PlanResult result;
+                result.success = true;
+                result.plan = reconstruct_plan(arena, actions, current.record);
+                result.final_state = current.state;
+                result.iterations = iterations;
+                result.cost = current.real_cost;
+                return result;
+            }
+
+            if (const float* g = best_cost.find(current.state); g && *g <= current.real_cost)
+                continue;
+            best_cost.assign(current.state, current.real_cost);
+
+            if (progress.due(iterations))
+                progress({ iterations, open.size(), current.estimated_cost,
+                           open.size() * node_bytes(initial) + arena.capacity() * sizeof(SearchNode) +
+                               best_cost.memory_bytes() });
+
+            batch.push_back(std::move(current));
         }
 
-        size_t key = state_key(current.state, cfg.fluent_bucket_size);
-        if (best_cost.count(key) && best_cost[key] <= current.real_cost)
+        if (!pool)
+        {
+            for (const Node& current : batch)
+            {
+                successors.generate(current.state, candidates);
+                for (auto a : candidates)
+                {
+                    const auto& action = actions[a];
+                    if (!is_applicable(action, current.state))
+                        continue;
+                    WorldState new_state = apply_action(action, current.state, axioms);
+                    const float ng = current.real_cost + static_cast<float>(action.cost);
+                    if (const float* g = best_cost.find(new_state); g && *g <= ng)
+                        continue;
+                    const float hn = h(new_state);
+                    if (hn != DEAD_END)
+                        push_successor(current, a, std::move(new_state), ng, hn);
+                }
+            }
             continue;
-        best_cost[key] = current.real_cost;
-
-        if (cfg.verbose && iterations % 1000 == 0)
-            std::cerr << "[astar] " << iterations << " iterations, " << open.size() << " open, " << best_cost.size()
-                      << " visited, best plan=" << current.plan.size() << "\n";
+        }
 
-        for (const auto& action : actions)
+        work.clear();
+        for (std::uint32_t b = 0; b < batch.size(); ++b)
         {
-            if (!is_applicable(action, current.state))
-                continue;
+            successors.generate(batch[b].state, candidates);
+            for (auto a : candidates)
+                work.emplace_back(b, a);
+        }
+        generated.assign(work.size(), {});
 
-            parser::WorldState new_state = apply_action(action, current.state, derived);
-            float ng = current.real_cost + static_cast<float>(action.cost);
+        const size_t used = std::min(lanes, work.size());
+        pool->parallel_for(used, [&](size_t l)
+        {
+            IHeuristic* heuristic = lane_heuristics[l].get();
+            for (size_t i = work.size() * l / used; i < work.size() * (l + 1) / used; ++i)
+            {
+                const Node& parent = batch[work[i].first];
+                const auto& action = actions[work[i].second];
+                if (!is_applicable(action, parent.state))
+                    continue;
+                Generated& out = generated[i];
+                out.applicable = true;
+                out.state = apply_action(action, parent.state, lane_axioms[l]);
+                out.h = heuristic ? heuristic->evaluate(out.state) : cfg.heuristic(out.state, goals);
+            }
+        });
 
-            size_t new_key = state_key(new_state, cfg.fluent_bucket_size);
-            if (best_cost.count(new_key) && best_cost[new_key] <= ng)
+        for (size_t i = 0; i < work.size(); ++i)
+        {
+            Generated& next = generated[i];
+            const Node& parent = batch[work[i].first];
+            const float ng = parent.real_cost + static_cast<float>(actions[work[i].second].cost);
+            if (!next.applicable || next.h == DEAD_END)
                 continue;
-
-            Node next;
-            next.real_cost = ng;
-            next.estimated_cost = ng + h(new_state, goals);
-            next.state = new_state;
-            next.plan = current.plan;
-            next.plan.push_back(action.name);
-            open.push(next);
+            if (const float* g = best_cost.find(next.state); g && *g <= ng)
+                continue;
+            push_successor(parent, work[i].second, std::move(next.state), ng, next.h);
         }
     }
 
+    PlanResult result;
+    result.final_state = initial;
+    result.iterations = iterations;
+    result.stop_reason = open.empty() ? StopReason::Exhausted : limits.reason();
     if (cfg.verbose)
-        std::cerr << "[astar] No plan found after " << iterations << " iterations\n";
-    return { false, {}, initial, iterations };
+        std::cerr << "[astar] No plan found after " << iterations << " iterations ("
+                  << stop_reason_name(result.stop_reason) << ")\n";
+    return result;
 }
 
 } // namespace pddl::solver
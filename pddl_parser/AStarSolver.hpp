@@ -2,7 +2,11 @@
 /// A* planner and PDDL action execution engine.
 #pragma once
 
+#include "DerivedEvaluator.hpp"
+#include "Heuristic.hpp"
 #include "ISolver.hpp"
+#include "OpenList.hpp"
+#include "ThreadPool.hpp"
 #include <functional>
 
 namespace pddl::solver
@@ -16,9 +20,34 @@ struct AStarConfig
     size_t max_iterations = 500'000; ///< Maximum number of A* iterations.
     int fluent_bucket_size = 10;     ///< Granularity for state hashing (0 = exact).
     bool verbose = false;            ///< Print debug info during search.
-
-    /// Custom heuristic (nullptr = default goal-count heuristic).
-    std::function<float(const parser::WorldState&, const std::vector<parser::Predicate>&)> heuristic = nullptr;
+    float weight = 1.0f;             ///< w in f = g + w * h (1 = A*, > 1 = weighted A*).
+
+    /// Open-list structure.  Buckets need integral action costs and
+    /// heuristic values (fractional estimates are rounded up).
+    OpenListKind open_list = OpenListKind::BinaryHeap;
+
+    /// Order among open nodes of equal f, then among nodes still tied.
+    TieBreaking tie_breaking = TieBreaking::None;
+    InsertionOrder insertion_order = InsertionOrder::Lifo;
+
+    /// Built-in heuristic, used when no custom @c heuristic is set.
+    HeuristicKind heuristic_kind = HeuristicKind::GoalCount;
+
+    /// Custom heuristic (nullptr = built-in @c heuristic_kind).  Returning
+    /// DEAD_END prunes the state.
+    std::function<float(const WorldState&, const std::vector<GroundCondition>&)> heuristic = nullptr;
+
+    /// Pool for parallel expansion (nullptr = serial).  Applicability checks,
+    /// effects and heuristic evaluations of the popped nodes are split over the
+    /// pool (one heuristic instance per thread), and successors are merged in
+    /// serial order, so the search does not depend on the number of threads.
+    /// A custom @c heuristic must then be thread-safe.
+    ThreadPool* expansion_pool = nullptr;
+
+    /// Nodes popped per parallel expansion.  1 keeps the serial expansion
+    /// order; more gives the pool work on cheap heuristics.  A goal is only
+    /// accepted as the best open node, so optimality is kept.
+    size_t expansion_batch = 1;
 };
 
 /// *****************************************************************************
@@ -39,27 +68,55 @@ public:
 
     /// Build the initial WorldState from parsed problem data.
     /// Converts @c (= (money alice) 7000) to fluents; keeps regular predicates.
-    static parser::WorldState build_initial_state(const parser::Problem& p);
+    static WorldState build_initial_state(const parser::Problem& p, AtomTable& atoms);
 
     /// Instantiate all domain actions with concrete objects from the problem.
+    /// Parameters only range over objects of their declared type, and
+    /// instances with a false static precondition (a predicate no effect
+    /// changes, or a comparison of unmodified fluents) are skipped; true static
+    /// preconditions are dropped.
+    /// Grounding is spread over @p pool; the output order does not depend on
+    /// the number of threads.
     /// @return One GroundAction per valid (action, object-combination).
-    static std::vector<GroundAction> instantiate_actions(const parser::Domain& d, const parser::Problem& p);
-
-    /// Instantiate all derived predicates with concrete objects.
-    static std::vector<GroundDerivedPredicate> instantiate_derived(const parser::Domain& d, const parser::Problem& p);
-
-    /// Expand derived predicates to a fixed point.
-    /// Called after build_initial_state and after each apply_action.
-    static parser::WorldState expand_derived(parser::WorldState ws, const std::vector<GroundDerivedPredicate>& derived);
+    static std::vector<GroundAction> instantiate_actions(const parser::Domain& d,
+                                                         const parser::Problem& p,
+                                                         AtomTable& atoms,
+                                                         ThreadPool& pool = ThreadPool::shared());
+
+    /// Instantiate all derived predicates with concrete objects (same pruning
+    /// and threading as instantiate_actions).
+    static std::vector<GroundDerivedPredicate> instantiate_derived(const parser::Domain& d,
+                                                                   const parser::Problem& p,
+                                                                   AtomTable& atoms,
+                                                                   ThreadPool& pool = ThreadPool::shared());
+
+    /// Remove actions and derived predicates that can never fire from @p initial
+    /// (delete-relaxed reachability; numeric and negative conditions are
+    /// assumed satisfiable).  Call after grounding, with the initial state.
+    static void prune_unreachable(const WorldState& initial,
+                                  std::vector<GroundAction>& actions,
+                                  std::vector<GroundDerivedPredicate>& derived);
+
+    /// Ground the problem goal (which never contains variables).
+    static std::vector<GroundCondition> ground_goals(const parser::Problem& p, AtomTable& atoms);
+
+    /// Recompute every derived predicate of @p ws (stratified least fixpoint).
+    /// Called after build_initial_state; search uses the incremental
+    /// DerivedEvaluator instead.
+    static WorldState expand_derived(WorldState ws, const std::vector<GroundDerivedPredicate>& derived);
 
     /// Check if all preconditions of an action hold in the given state.
-    static bool is_applicable(const GroundAction& action, const parser::WorldState& ws);
+    static bool is_applicable(const GroundAction& action, const WorldState& ws);
 
     /// Apply all effects of an action and return the resulting state.
     /// Automatically runs expand_derived if @p derived is non-empty.
-    static parser::WorldState apply_action(const GroundAction& action,
-                                           parser::WorldState ws,
-                                           const std::vector<GroundDerivedPredicate>& derived = {});
+    static WorldState apply_action(const GroundAction& action,
+                                   WorldState ws,
+                                   const std::vector<GroundDerivedPredicate>& derived = {});
+
+    /// Apply all effects of an action and incrementally update the derived
+    /// predicates depending on what changed.
+    static WorldState apply_action(const GroundAction& action, WorldState ws, DerivedEvaluator& derived);
 
 private:
 
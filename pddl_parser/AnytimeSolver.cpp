@@ -0,0 +1,172 @@
+#include "AnytimeSolver.hpp"
+#include "ClosedList.hpp"
+#include "SuccessorGenerator.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// ISolver::solve implementation
+/// *****************************************************************************
+PlanResult AnytimeAStarSolver::solve(const SolverContext& ctx)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto started = Clock::now();
+    const auto& initial = ctx.initial;
+    const auto& actions = ctx.actions;
+    const auto& goals = ctx.goals;
+    const auto& cfg = m_config;
+    const auto& search = cfg.search;
+
+    std::unique_ptr<IHeuristic> builtin = search.heuristic ? nullptr : make_heuristic(search.heuristic_kind, ctx);
+    auto h = [&](const WorldState& ws) { return builtin ? builtin->evaluate(ws) : search.heuristic(ws, goals); };
+    StopCondition limits(ctx, search.max_iterations, cfg.time_limit);
+    ProgressReporter progress(ctx);
+
+    const size_t atom_count = std::max(ctx.atoms.atom_count(), initial.get_words().size() * WorldState::WORD_BITS);
+    const size_t fluent_count = std::max(ctx.atoms.fluent_count(), initial.get_fluents().size());
+    auto make_open = [&] { return OpenList(search.open_list, search.tie_breaking, search.insertion_order); };
+
+    std::vector<SearchNode> arena;  ///< Parent links of every generated node.
+    ClosedList best_cost(atom_count, fluent_count, search.fluent_bucket_size); ///< Best g of every generated state.
+    ClosedList expanded(atom_count, fluent_count, search.fluent_bucket_size);  ///< States expanded by this search.
+    OpenList open = make_open();
+    std::vector<Node> inconsistent; ///< Improved after their expansion; reopened by the next search.
+
+    const SuccessorGenerator successors(actions);
+    DerivedEvaluator axioms(ctx.derived);
+    std::vector<std::uint32_t> candidates;
+
+    float weight = std::max(1.0f, cfg.initial_weight);
+    PlanResult result;
+    result.final_state = initial;
+    float incumbent = std::numeric_limits<float>::infinity();
+
+    arena.push_back({ NO_PARENT, 0 });
+    Node start;
+    start.real_cost = 0;
+    start.heuristic = h(initial);
+    start.estimated_cost = weight * start.heuristic;
+    start.state = initial;
+    start.state.set_hash_bucket(search.fluent_bucket_size); // Successors inherit the bucket size.
+    start.record = 0;
+    best_cost.assign(start.state, 0);
+    if (start.heuristic != DEAD_END)
+        open.push(std::move(start));
+
+    size_t iterations = 0;
+    bool stopped = false;
+    for (;;)
+    {
+        // Improve the plan at the current weight; ends when the goal is popped.
+        bool reached = false;
+        while (!open.empty())
+        {
+            if (limits(iterations))
+            {
+                stopped = true;
+                break;
+            }
+            ++iterations;
+            Node current = open.pop();
+
+            if (current.real_cost > *best_cost.find(current.state) || current.real_cost + current.heuristic >= incumbent)
+                continue;
+            if (const float* g = expanded.find(current.state); g && *g <= current.real_cost)
+                continue;
+
+            if (current.state.is_goal_reached(goals))
+            {
+                incumbent = current.real_cost;
+                result.success = true;
+                result.plan = reconstruct_plan(arena, actions, current.record);
+                result.final_state = current.state;
+                result.cost = incumbent;
+                result.improvements.push_back(
+                    { incumbent, std::chrono::duration<double>(Clock::now() - started).count(), iterations });
+                if (search.verbose)
+                    std::cerr << "[ara*] Plan of cost " << incumbent << " at weight " << weight << " after "
+                              << iterations << " iterations\n";
+                reached = true;
+                break;
+            }
+            expanded.assign(current.state, current.real_cost);
+
+            if (progress.due(iterations))
+            {
+                const size_t queued = open.size() + inconsistent.size();
+                progress({ iterations, queued, current.estimated_cost,
+                           queued * node_bytes(initial) + arena.capacity() * sizeof(SearchNode) +
+                               best_cost.memory_bytes() + expanded.memory_bytes() });
+            }
+
+            successors.generate(current.state, candidates);
+            for (auto a : candidates)
+            {
+                const auto& action = actions[a];
+                if (!AStarSolver::is_applicable(action, current.state))
+                    continue;
+
+                WorldState new_state = AStarSolver::apply_action(action, current.state, axioms);
+                const float ng = current.real_cost + static_cast<float>(action.cost);
+                if (const float* g = best_cost.find(new_state); g && *g <= ng)
+                    continue;
+
+                const float hn = h(new_state);
+                if (hn == DEAD_END || ng + hn >= incumbent)
+                    continue;
+                best_cost.assign(new_state, ng);
+
+                Node next;
+                next.real_cost = ng;
+                next.heuristic = hn;
+                next.estimated_cost = ng + weight * hn;
+                next.record = arena.size();
+                arena.push_back({ current.record, a });
+                const bool reopened = expanded.find(new_state) != nullptr;
+                next.state = std::move(new_state);
+                if (reopened)
+                    inconsistent.push_back(std::move(next));
+                else
+                    open.push(std::move(next));
+            }
+        }
+
+        // Done: out of time, search space exhausted, or optimal at weight 1.
+        if (stopped || (!reached && inconsistent.empty()) || (reached && weight <= 1.0f))
+            break;
+
+        // Repair: lower the weight, re-key the open nodes and reopen the inconsistent ones.
+        weight = std::max(1.0f, weight - cfg.weight_step);
+        std::vector<Node> nodes = std::move(inconsistent);
+        inconsistent.clear();
+        while (!open.empty())
+            nodes.push_back(open.pop());
+        open = make_open();
+        for (auto& node : nodes)
+        {
+            if (node.real_cost > *best_cost.find(node.state) || node.real_cost + node.heuristic >= incumbent)
+                continue;
+            node.estimated_cost = node.real_cost + weight * node.heuristic;
+            open.push(std::move(node));
+        }
+        expanded = ClosedList(atom_count, fluent_count, search.fluent_bucket_size);
+        if (open.empty())
+            break;
+    }
+
+    if (stopped)
+        result.stop_reason = limits.reason();
+    else if (!result.success)
+        result.stop_reason = StopReason::Exhausted;
+    if (search.verbose && !result.success)
+        std::cerr << "[ara*] No plan found after " << iterations << " iterations ("
+                  << stop_reason_name(result.stop_reason) << ")\n";
+    result.iterations = iterations;
+    return result;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,73 @@
+/// @file AnytimeSolver.hpp
+/// Weighted A* and anytime repairing A* (ARA*) planners.
+#pragma once
+
+#include "AStarSolver.hpp"
+#include <chrono>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Weighted A*: A* on f = g + w * h.
+///
+/// With an admissible heuristic the plan costs at most @c w times the optimum;
+/// larger weights expand far fewer nodes on large plateaus.
+/// *****************************************************************************
+class WeightedAStarSolver: public AStarSolver
+{
+public:
+
+    explicit WeightedAStarSolver(float weight, AStarConfig cfg = {}) : AStarSolver(weighted(std::move(cfg), weight)) {}
+
+private:
+
+    static AStarConfig weighted(AStarConfig cfg, float weight)
+    {
+        cfg.weight = weight;
+        return cfg;
+    }
+};
+
+/// *****************************************************************************
+/// Configuration for the anytime planner.
+/// *****************************************************************************
+struct AnytimeConfig
+{
+    /// Heuristic, open list, hashing and total iteration limit (@c weight is ignored).
+    AStarConfig search;
+
+    float initial_weight = 5.0f;             ///< Weight of the first search.
+    float weight_step = 1.0f;                ///< Weight decrease after each search, down to 1.
+    std::chrono::milliseconds time_limit{0}; ///< Limit of the whole run, besides SolverContext::deadline (0 = none).
+};
+
+/// *****************************************************************************
+/// Anytime repairing A* (Likhachev et al.).
+///
+/// Runs a weighted A* to get a first plan quickly, then lowers the weight and
+/// repairs the search instead of restarting it: the open nodes are re-keyed
+/// with the new weight, states whose cost improved after their expansion are
+/// reopened from an "inconsistent" list, and nodes that cannot beat the best
+/// plan (g + h >= its cost, with an admissible h) are pruned.  Every better
+/// plan is recorded in PlanResult::improvements.
+///
+/// Stops when the search at weight 1 completes (the last plan is optimal if
+/// the heuristic is admissible), when no node can improve the plan, or at the
+/// deadline or iteration limit, returning the best plan so far.
+/// *****************************************************************************
+class AnytimeAStarSolver: public ISolver
+{
+public:
+
+    explicit AnytimeAStarSolver(AnytimeConfig cfg = {}) : m_config(std::move(cfg)) {}
+
+    /// @copydoc ISolver::solve
+    PlanResult solve(const SolverContext& ctx) override;
+
+private:
+
+    AnytimeConfig m_config;
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,103 @@
+#include "AsyncSolve.hpp"
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+SolveHandle& SolveHandle::operator=(SolveHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_result.valid())
+        {
+            cancel();
+            m_result.wait();
+        }
+        m_shared = std::move(other.m_shared);
+        m_result = std::move(other.m_result);
+    }
+    return *this;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+SolveHandle::~SolveHandle()
+{
+    if (m_result.valid())
+    {
+        cancel();
+        m_result.wait();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void SolveHandle::cancel()
+{
+    m_shared->stop.request_stop();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SolveHandle::ready() const
+{
+    return m_result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void SolveHandle::wait() const
+{
+    m_result.wait();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SolveHandle::wait_for(std::chrono::milliseconds timeout) const
+{
+    return m_result.wait_for(timeout) == std::future_status::ready;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+PlanResult SolveHandle::get()
+{
+    return m_result.get();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+SearchProgress SolveHandle::progress() const
+{
+    std::lock_guard lock(m_shared->mutex);
+    return m_shared->progress;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+SolveHandle solve_async(std::shared_ptr<ISolver> solver, SolverContext ctx, ThreadPool& executor)
+{
+    auto shared = std::make_shared<SolveHandle::Shared>();
+    auto promise = std::make_shared<std::promise<PlanResult>>();
+    SolveHandle handle(shared, promise->get_future());
+
+    executor.submit([solver = std::move(solver), ctx = std::move(ctx), shared, promise]() mutable
+    {
+        const std::stop_token caller = ctx.stop;
+        std::stop_callback forward(caller, [&] { shared->stop.request_stop(); });
+        ctx.stop = shared->stop.get_token();
+        ctx.progress = [&, forward_progress = std::move(ctx.progress)](const SearchProgress& snapshot)
+        {
+            {
+                std::lock_guard lock(shared->mutex);
+                shared->progress = snapshot;
+            }
+            if (forward_progress)
+                forward_progress(snapshot);
+        };
+
+        try
+        {
+            promise->set_value(solver->solve(ctx));
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return handle;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,86 @@
+/// @file AsyncSolve.hpp
+/// Asynchronous solve() runs on a shared executor.
+#pragma once
+
+#include "ISolver.hpp"
+#include "ThreadPool.hpp"
+#include <future>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Handle of a solve() running on an executor (see solve_async()).
+///
+/// The handle owns the stop source of the run: cancel() asks the solver to
+/// return early, with its partial result.  Since the context refers to data
+/// owned by the caller, destroying a handle whose run is still going cancels
+/// it and waits for it.  The latest progress snapshot can be read from any
+/// thread.
+/// *****************************************************************************
+class SolveHandle
+{
+public:
+
+    SolveHandle(SolveHandle&& other) noexcept = default;
+    SolveHandle& operator=(SolveHandle&& other) noexcept;
+
+    /// Cancel and wait for the run if its result was not taken.
+    ~SolveHandle();
+
+    /// Ask the solver to stop; get() then returns its result so far.
+    void cancel();
+
+    /// True once the result is available.
+    bool ready() const;
+
+    /// Block until the run is over.
+    void wait() const;
+
+    /// Block until the run is over or @p timeout elapsed.
+    /// @return True if the run is over.
+    bool wait_for(std::chrono::milliseconds timeout) const;
+
+    /// Wait for the run and return its result; call once.
+    /// @throws The exception thrown by the solver, if any.
+    PlanResult get();
+
+    /// Latest progress snapshot (all zero before the first one).
+    SearchProgress progress() const;
+
+private:
+
+    /// State shared with the running task.
+    struct Shared
+    {
+        std::stop_source stop;    ///< Cancellation of the run.
+        mutable std::mutex mutex; ///< Guards @c progress.
+        SearchProgress progress;  ///< Latest snapshot.
+    };
+
+    SolveHandle(std::shared_ptr<Shared> shared, std::future<PlanResult> result)
+        : m_shared(std::move(shared)), m_result(std::move(result))
+    {
+    }
+
+    friend SolveHandle solve_async(std::shared_ptr<ISolver>, SolverContext, ThreadPool&);
+
+private:
+
+    std::shared_ptr<Shared> m_shared; ///< Stop source and progress of the run.
+    std::future<PlanResult> m_result; ///< Result of the run (invalid once taken).
+};
+
+/// *****************************************************************************
+/// Queue solve() of @p solver on @p ctx on @p executor and return at once.
+///
+/// The data referred to by @p ctx must outlive the run (see SolveHandle).
+/// A stop requested on @p ctx.stop is forwarded to the run, and
+/// @p ctx.progress, if set, still receives every snapshot on the executor
+/// thread.  Solvers must not be shared by concurrent runs.
+/// *****************************************************************************
+SolveHandle solve_async(std::shared_ptr<ISolver> solver,
+                        SolverContext ctx,
+                        ThreadPool& executor = ThreadPool::shared());
+
+} // namespace pddl::solver
@@ -0,0 +1,120 @@
+#include "AtomTable.hpp"
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+AtomTable::AtomTable(std::shared_ptr<parser::SymbolTable> symbols)
+    : m_symbols(symbols ? std::move(symbols) : std::make_shared<parser::SymbolTable>())
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+size_t AtomTable::KeyHash::operator()(std::vector<parser::SymbolId> const& key) const
+{
+    size_t seed = key.size();
+    for (auto id : key)
+        seed ^= id + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+AtomTable::Key AtomTable::make_key(std::string const& head, std::vector<std::string> const& args)
+{
+    Key key;
+    key.reserve(args.size() + 1);
+    key.push_back(m_symbols->intern(head));
+    for (const auto& a : args)
+        key.push_back(m_symbols->intern(a));
+    return key;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::optional<AtomTable::Key> AtomTable::find_key(std::string const& head, std::vector<std::string> const& args) const
+{
+    Key key;
+    key.reserve(args.size() + 1);
+    auto id = m_symbols->find(head);
+    if (!id)
+        return std::nullopt;
+    key.push_back(*id);
+    for (const auto& a : args)
+    {
+        if (!(id = m_symbols->find(a)))
+            return std::nullopt;
+        key.push_back(*id);
+    }
+    return key;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+AtomId AtomTable::atom(std::string const& predicate, std::vector<std::string> const& args)
+{
+    Key key = make_key(predicate, args);
+    auto [it, inserted] = m_atom_ids.try_emplace(key, static_cast<AtomId>(m_atoms.size()));
+    if (inserted)
+        m_atoms.push_back(std::move(key));
+    return it->second;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+FluentId AtomTable::fluent(std::string const& function, std::vector<std::string> const& args)
+{
+    Key key = make_key(function, args);
+    auto [it, inserted] = m_fluent_ids.try_emplace(key, static_cast<FluentId>(m_fluents.size()));
+    if (inserted)
+        m_fluents.push_back(std::move(key));
+    return it->second;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::optional<AtomId> AtomTable::find_atom(std::string const& predicate, std::vector<std::string> const& args) const
+{
+    auto key = find_key(predicate, args);
+    if (!key)
+        return std::nullopt;
+    auto it = m_atom_ids.find(*key);
+    if (it == m_atom_ids.end())
+        return std::nullopt;
+    return it->second;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::optional<FluentId> AtomTable::find_fluent(std::string const& function, std::vector<std::string> const& args) const
+{
+    auto key = find_key(function, args);
+    if (!key)
+        return std::nullopt;
+    auto it = m_fluent_ids.find(*key);
+    if (it == m_fluent_ids.end())
+        return std::nullopt;
+    return it->second;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::string AtomTable::atom_name(AtomId id) const
+{
+    const Key& key = m_atoms[id];
+    std::string s = "(" + m_symbols->name(key[0]);
+    for (size_t i = 1; i < key.size(); ++i)
+        s += " " + m_symbols->name(key[i]);
+    s += ")";
+    return s;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::string AtomTable::fluent_name(FluentId id) const
+{
+    const Key& key = m_fluents[id];
+    std::string s = m_symbols->name(key[0]) + "(";
+    for (size_t i = 1; i < key.size(); ++i)
+    {
+        if (i > 1)
+            s += ",";
+        s += m_symbols->name(key[i]);
+    }
+    s += ")";
+    return s;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,114 @@
+/// @file AtomTable.hpp
+/// Registry of ground atoms and ground fluents discovered during grounding.
+#pragma once
+
+#include "SymbolTable.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// Dense index of a ground boolean atom, e.g. @c (on a b).
+using AtomId = std::uint32_t;
+
+/// Dense index of a ground numeric fluent, e.g. @c (money alice).
+using FluentId = std::uint32_t;
+
+/// *****************************************************************************
+/// Interning table for ground atoms and ground fluents.
+///
+/// A ground atom (resp. fluent) is identified by the symbol IDs of its
+/// predicate (resp. function) name followed by its argument objects.  Each
+/// distinct key receives a dense ID the first time it is seen, so the grounded
+/// layer (GroundAction, WorldState, …) never has to compare or hash strings.
+/// The text form is kept for debug printing only.
+/// *****************************************************************************
+class AtomTable
+{
+public:
+
+    explicit AtomTable(std::shared_ptr<parser::SymbolTable> symbols);
+
+    /// Return the ID of the ground atom @c (predicate args...), interning it if needed.
+    AtomId atom(std::string const& predicate, std::vector<std::string> const& args);
+
+    /// Return the ID of the ground fluent @c (function args...), interning it if needed.
+    FluentId fluent(std::string const& function, std::vector<std::string> const& args);
+
+    /// Return the ID of the ground atom @c (predicate args...) if it was interned.
+    std::optional<AtomId> find_atom(std::string const& predicate, std::vector<std::string> const& args) const;
+
+    /// Return the ID of the ground fluent @c (function args...) if it was interned.
+    std::optional<FluentId> find_fluent(std::string const& function, std::vector<std::string> const& args) const;
+
+    /// Number of ground atoms interned so far.
+    size_t atom_count() const
+    {
+        return m_atoms.size();
+    }
+
+    /// Number of ground fluents interned so far.
+    size_t fluent_count() const
+    {
+        return m_fluents.size();
+    }
+
+    /// Symbol IDs of an atom: predicate name followed by its arguments.
+    std::vector<parser::SymbolId> const& atom_symbols(AtomId id) const
+    {
+        return m_atoms[id];
+    }
+
+    /// Symbol IDs of a fluent: function name followed by its arguments.
+    std::vector<parser::SymbolId> const& fluent_symbols(FluentId id) const
+    {
+        return m_fluents[id];
+    }
+
+    /// Debug text of an atom, e.g. "(on a b)".
+    std::string atom_name(AtomId id) const;
+
+    /// Debug text of a fluent, e.g. "money(alice)" (same format as FluentRef::key).
+    std::string fluent_name(FluentId id) const;
+
+    /// The identifier table shared with the parsed domain.
+    parser::SymbolTable& symbols()
+    {
+        return *m_symbols;
+    }
+
+    /// @copydoc symbols()
+    parser::SymbolTable const& symbols() const
+    {
+        return *m_symbols;
+    }
+
+private:
+
+    /// Hash of a symbol-ID key (boost::hash_combine mixing).
+    struct KeyHash
+    {
+        size_t operator()(std::vector<parser::SymbolId> const& key) const;
+    };
+
+    using Key = std::vector<parser::SymbolId>;
+
+    Key make_key(std::string const& head, std::vector<std::string> const& args);
+
+    /// Like make_key but without interning; std::nullopt if a name is unknown.
+    std::optional<Key> find_key(std::string const& head, std::vector<std::string> const& args) const;
+
+private:
+
+    std::shared_ptr<parser::SymbolTable> m_symbols;
+    std::vector<Key> m_atoms;
+    std::vector<Key> m_fluents;
+    std::unordered_map<Key, AtomId, KeyHash> m_atom_ids;
+    std::unordered_map<Key, FluentId, KeyHash> m_fluent_ids;
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,214 @@
+#include "Bytecode.hpp"
+#include "ISolver.hpp"
+#include <optional>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Comparison with its operands swapped: @c (< c f) is @c (> f c).
+/// *****************************************************************************
+static Comparator mirror(Comparator op)
+{
+    switch (op)
+    {
+        case Comparator::Lt:
+            return Comparator::Gt;
+        case Comparator::Le:
+            return Comparator::Ge;
+        case Comparator::Gt:
+            return Comparator::Lt;
+        case Comparator::Ge:
+            return Comparator::Le;
+        default:
+            return op;
+    }
+}
+
+/// *****************************************************************************
+/// Compile one condition into a test instruction.
+/// @return std::nullopt when the condition is constant-true.
+/// *****************************************************************************
+static std::optional<Instruction> compile_condition(GroundCondition const& c, std::uint32_t skip)
+{
+    Instruction in;
+    in.skip = skip;
+
+    switch (c.kind)
+    {
+        case GroundCondition::Kind::Fact:
+            in.op = OpCode::TestFact;
+            in.index = c.atom;
+            return in;
+        case GroundCondition::Kind::NotFact:
+            in.op = OpCode::TestNotFact;
+            in.index = c.atom;
+            return in;
+        case GroundCondition::Kind::Compare:
+            break;
+    }
+
+    in.cmp = c.op;
+    if (c.lhs.is_fluent && c.rhs.is_fluent)
+    {
+        in.op = OpCode::CompareFluentFluent;
+        in.index = c.lhs.fluent;
+        in.index2 = c.rhs.fluent;
+    }
+    else if (c.lhs.is_fluent)
+    {
+        in.op = OpCode::CompareFluentConst;
+        in.index = c.lhs.fluent;
+        in.value = c.rhs.value;
+    }
+    else if (c.rhs.is_fluent)
+    {
+        in.op = OpCode::CompareFluentConst;
+        in.cmp = mirror(c.op);
+        in.index = c.rhs.fluent;
+        in.value = c.lhs.value;
+    }
+    else if (compare(c.op, c.lhs.value, c.rhs.value))
+    {
+        return std::nullopt;
+    }
+    else
+    {
+        in.op = OpCode::False;
+    }
+    return in;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+Program compile_conditions(std::vector<GroundCondition> const& conditions)
+{
+    Program program;
+    program.reserve(conditions.size());
+    for (const auto& c : conditions)
+    {
+        if (auto in = compile_condition(c, /*skip=*/0))
+            program.push_back(*in);
+    }
+    return program;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+Program compile_effects(std::vector<GroundEffect> const& effects)
+{
+    Program program;
+    program.reserve(effects.size());
+    for (const auto& eff : effects)
+    {
+        // Conditional effect: a guard skipping the single write that follows.
+        if (eff.when.has_value())
+        {
+            if (auto guard = compile_condition(*eff.when, /*skip=*/1))
+                program.push_back(*guard);
+        }
+
+        Instruction in;
+        switch (eff.kind)
+        {
+            case GroundEffect::Kind::Add:
+                in.op = OpCode::AddFact;
+                in.index = eff.atom;
+                break;
+            case GroundEffect::Kind::Delete:
+                in.op = OpCode::DeleteFact;
+                in.index = eff.atom;
+                break;
+            case GroundEffect::Kind::Numeric:
+            {
+                const bool assign = (eff.op == parser::NumericOp::Assign);
+                const double sign = (eff.op == parser::NumericOp::Decrease) ? -1.0 : 1.0;
+                in.index = eff.fluent;
+                if (eff.value.is_fluent)
+                {
+                    in.op = assign ? OpCode::AssignFluent : OpCode::AddFluent;
+                    in.index2 = eff.value.fluent;
+                    in.value = sign;
+                }
+                else
+                {
+                    in.op = assign ? OpCode::AssignConst : OpCode::AddConst;
+                    in.value = assign ? eff.value.value : sign * eff.value.value;
+                }
+                break;
+            }
+        }
+        program.push_back(in);
+    }
+    return program;
+}
+
+/// *****************************************************************************
+/// Evaluate a test instruction.
+/// *****************************************************************************
+static inline bool test(Instruction const& in, WorldState const& ws)
+{
+    switch (in.op)
+    {
+        case OpCode::TestFact:
+            return ws.holds(in.index);
+        case OpCode::TestNotFact:
+            return !ws.holds(in.index);
+        case OpCode::CompareFluentConst:
+            return compare(in.cmp, ws.get_fluent(in.index), in.value);
+        case OpCode::CompareFluentFluent:
+            return compare(in.cmp, ws.get_fluent(in.index), ws.get_fluent(in.index2));
+        default:
+            return false;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool check(Program const& program, WorldState const& ws)
+{
+    for (size_t pc = 0; pc < program.size(); ++pc)
+    {
+        const Instruction& in = program[pc];
+        if (!test(in, ws))
+        {
+            if (in.skip == 0)
+                return false;
+            pc += in.skip;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void execute(Program const& program, WorldState& ws)
+{
+    for (size_t pc = 0; pc < program.size(); ++pc)
+    {
+        const Instruction& in = program[pc];
+        switch (in.op)
+        {
+            case OpCode::AddFact:
+                ws.add(in.index);
+                break;
+            case OpCode::DeleteFact:
+                ws.remove(in.index);
+                break;
+            case OpCode::AddConst:
+                ws.set_fluent(in.index, ws.get_fluent(in.index) + in.value);
+                break;
+            case OpCode::AssignConst:
+                ws.set_fluent(in.index, in.value);
+                break;
+            case OpCode::AddFluent:
+                ws.set_fluent(in.index, ws.get_fluent(in.index) + in.value * ws.get_fluent(in.index2));
+                break;
+            case OpCode::AssignFluent:
+                ws.set_fluent(in.index, ws.get_fluent(in.index2));
+                break;
+            default:
+                if (!test(in, ws))
+                    pc += in.skip;
+                break;
+        }
+    }
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,76 @@
+/// @file Bytecode.hpp
+/// Compact instruction streams compiled from ground preconditions and effects.
+#pragma once
+
+#include "WorldState.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+struct GroundEffect;
+
+/// *****************************************************************************
+/// Operation performed by one Instruction.
+///
+/// Test operations read the state; when their test is false they either make
+/// the whole program fail (@c skip == 0) or skip the next @c skip
+/// instructions, which is how conditional @c (when ...) blocks are encoded.
+/// *****************************************************************************
+enum class OpCode : std::uint8_t
+{
+    TestFact,            ///< atom @c index is true.
+    TestNotFact,         ///< atom @c index is false.
+    CompareFluentConst,  ///< fluent @c index @c cmp @c value.
+    CompareFluentFluent, ///< fluent @c index @c cmp fluent @c index2.
+    False,               ///< Always false (comparison of constants folded at compile time).
+    AddFact,             ///< Set atom @c index.
+    DeleteFact,          ///< Clear atom @c index.
+    AddConst,            ///< fluent @c index += @c value (decrease is compiled with a negated value).
+    AssignConst,         ///< fluent @c index = @c value.
+    AddFluent,           ///< fluent @c index += @c value * fluent @c index2.
+    AssignFluent,        ///< fluent @c index = fluent @c index2.
+};
+
+/// *****************************************************************************
+/// One instruction of a compiled program.
+/// *****************************************************************************
+struct Instruction
+{
+    OpCode        op     = OpCode::False;   ///< Operation.
+    Comparator    cmp    = Comparator::Eq;  ///< Comparison for Compare* operations.
+    std::uint32_t skip   = 0;               ///< Tests: 0 = fail the program, n = skip n instructions.
+    std::uint32_t index  = 0;               ///< Atom or fluent operand / target.
+    std::uint32_t index2 = 0;               ///< Second fluent operand.
+    double        value  = 0.0;             ///< Constant operand.
+};
+
+/// A compiled program: a flat sequence of instructions.
+using Program = std::vector<Instruction>;
+
+/// *****************************************************************************
+/// Compile a conjunction of ground conditions into a test-only program.
+/// Conditions that are constant-true are dropped.
+/// *****************************************************************************
+Program compile_conditions(std::vector<GroundCondition> const& conditions);
+
+/// *****************************************************************************
+/// Compile a list of ground effects into an update program.  A conditional
+/// effect becomes a guard test that skips the following write when false.
+/// *****************************************************************************
+Program compile_effects(std::vector<GroundEffect> const& effects);
+
+/// *****************************************************************************
+/// Run a test-only program.
+/// @return True if every test holds in @p ws.
+/// *****************************************************************************
+bool check(Program const& program, WorldState const& ws);
+
+/// *****************************************************************************
+/// Run an update program on @p ws in place.  Guards are evaluated against the
+/// state updated by the preceding instructions.
+/// *****************************************************************************
+void execute(Program const& program, WorldState& ws);
+
+} // namespace pddl::solver
@@ -0,0 +1,106 @@
+#include "ClosedList.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+ClosedList::ClosedList(size_t atom_count, size_t fluent_count, int bucket_size)
+    : m_atom_words((atom_count + WorldState::WORD_BITS - 1) / WorldState::WORD_BITS),
+      m_stride(m_atom_words + fluent_count),
+      m_bucket_size(bucket_size),
+      m_slots(1024, EMPTY),
+      m_scratch(m_stride, 0)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void ClosedList::pack(const WorldState& ws)
+{
+    std::fill(m_scratch.begin(), m_scratch.end(), 0);
+
+    const auto& words = ws.get_words();
+    std::copy_n(words.begin(), std::min(words.size(), m_atom_words), m_scratch.begin());
+
+    const auto& fluents = ws.get_fluents();
+    const size_t fluent_count = std::min(fluents.size(), m_stride - m_atom_words);
+    for (size_t i = 0; i < fluent_count; ++i)
+    {
+        const double val = fluents[i];
+        m_scratch[m_atom_words + i] = (m_bucket_size > 0)
+                                          ? static_cast<std::uint64_t>(static_cast<long long>(val / m_bucket_size))
+                                          : std::bit_cast<std::uint64_t>(val + 0.0); // +0.0 folds -0.0 into 0.0
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+size_t ClosedList::probe(std::uint64_t h) const
+{
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask)
+    {
+        const std::uint32_t idx = m_slots[i];
+        if (idx == EMPTY)
+            return i;
+        if (m_hashes[idx] == h &&
+            std::equal(m_scratch.begin(), m_scratch.end(), m_pool.begin() + static_cast<ptrdiff_t>(idx * m_stride)))
+            return i;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void ClosedList::grow()
+{
+    std::vector<std::uint32_t> slots(m_slots.size() * 2, EMPTY);
+    const size_t mask = slots.size() - 1;
+    for (std::uint32_t idx = 0; idx < m_costs.size(); ++idx)
+    {
+        size_t i = m_hashes[idx] & mask;
+        while (slots[i] != EMPTY)
+            i = (i + 1) & mask;
+        slots[i] = idx;
+    }
+    m_slots = std::move(slots);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+const float* ClosedList::find(const WorldState& ws)
+{
+    pack(ws);
+    const std::uint32_t idx = m_slots[probe(ws.hash())];
+    return (idx == EMPTY) ? nullptr : &m_costs[idx];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void ClosedList::assign(const WorldState& ws, float g)
+{
+    pack(ws);
+    const std::uint64_t h = ws.hash();
+    size_t slot = probe(h);
+    if (m_slots[slot] != EMPTY)
+    {
+        m_costs[m_slots[slot]] = g;
+        return;
+    }
+
+    // Keep the load factor below 1/2 so that probe sequences stay short.
+    if (2 * (m_costs.size() + 1) > m_slots.size())
+    {
+        grow();
+        slot = probe(h);
+    }
+    m_slots[slot] = static_cast<std::uint32_t>(m_costs.size());
+    m_pool.insert(m_pool.end(), m_scratch.begin(), m_scratch.end());
+    m_hashes.push_back(h);
+    m_costs.push_back(g);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+size_t ClosedList::memory_bytes() const
+{
+    return m_pool.capacity() * sizeof(std::uint64_t) + m_hashes.capacity() * sizeof(std::uint64_t) +
+           m_costs.capacity() * sizeof(float) + m_slots.capacity() * sizeof(std::uint32_t);
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,76 @@
+/// @file ClosedList.hpp
+/// Collision-safe closed list storing packed copies of visited states.
+#pragma once
+
+#include "WorldState.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Closed list mapping each distinct visited state to its best g-cost.
+///
+/// The Zobrist hash of a state is only used as a fingerprint: every entry
+/// keeps a packed copy of its state in a flat pool (fact bitset words followed
+/// by one word per bucketed fluent) and a lookup compares that copy word by
+/// word, so two distinct states whose hashes collide are never merged.  The
+/// index is an open-addressing table of 32-bit pool indices, keeping the
+/// per-state overhead to the packed state plus a few words.
+///
+/// "Distinct" follows the same bucketization as WorldState::hash(): fluents
+/// are compared by @c trunc(value / bucket_size) (exact values when 0).
+/// *****************************************************************************
+class ClosedList
+{
+public:
+
+    /// @param atom_count    Number of ground atoms (AtomTable::atom_count()).
+    /// @param fluent_count  Number of ground fluents (AtomTable::fluent_count()).
+    /// @param bucket_size   Fluent bucket size (0 = exact).
+    ClosedList(size_t atom_count, size_t fluent_count, int bucket_size);
+
+    /// Best g-cost recorded for @p ws, or nullptr if the state was never recorded.
+    const float* find(const WorldState& ws);
+
+    /// Record @p g as the best g-cost of @p ws (inserting the state if needed).
+    void assign(const WorldState& ws, float g);
+
+    /// Number of distinct states recorded.
+    size_t size() const
+    {
+        return m_costs.size();
+    }
+
+    /// Bytes allocated for the packed states and the index.
+    size_t memory_bytes() const;
+
+private:
+
+    /// Marker of an empty slot in the index.
+    static constexpr std::uint32_t EMPTY = UINT32_MAX;
+
+    /// Pack @p ws into @c m_scratch.
+    void pack(const WorldState& ws);
+
+    /// Slot holding the packed state in @c m_scratch (whose hash is @p h), or
+    /// the empty slot where it should be inserted.
+    size_t probe(std::uint64_t h) const;
+
+    /// Double the index capacity and re-insert every entry.
+    void grow();
+
+private:
+
+    size_t m_atom_words;                 ///< Words of the packed fact bitset.
+    size_t m_stride;                     ///< Words per packed state.
+    int m_bucket_size;                   ///< Fluent bucket size (0 = exact).
+    std::vector<std::uint64_t> m_pool;   ///< Packed states, @c m_stride words each.
+    std::vector<std::uint64_t> m_hashes; ///< Fingerprint of each packed state.
+    std::vector<float> m_costs;          ///< Best g-cost of each packed state.
+    std::vector<std::uint32_t> m_slots;  ///< Open-addressing index into the pool.
+    std::vector<std::uint64_t> m_scratch;///< Packed form of the state being looked up.
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,272 @@
+#include "DerivedEvaluator.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+namespace pddl::solver
+{
+
+/// Marker of a rule whose non-recursive conditions are false.
+static constexpr std::uint32_t DEAD = UINT32_MAX;
+
+//---------------------------------------------------------------------------------------------------------------------
+DerivedEvaluator::DerivedEvaluator(const std::vector<GroundDerivedPredicate>& derived)
+    : m_derived(&derived), m_stratum(derived.size(), 0), m_epoch_of(derived.size(), 0), m_missing(derived.size(), 0)
+{
+    auto add_reader = [](std::vector<std::vector<std::uint32_t>>& readers, std::uint32_t id, std::uint32_t r)
+    {
+        if (id >= readers.size())
+            readers.resize(id + 1);
+        if (readers[id].empty() || readers[id].back() != r)
+            readers[id].push_back(r);
+    };
+
+    for (std::uint32_t r = 0; r < derived.size(); ++r)
+    {
+        const auto& gdp = derived[r];
+        if (gdp.head >= m_head_rules.size())
+            m_head_rules.resize(gdp.head + 1);
+        m_head_rules[gdp.head].push_back(r);
+
+        for (const auto& c : gdp.conditions)
+        {
+            if (c.kind != GroundCondition::Kind::Compare)
+                add_reader(m_atom_readers, c.atom, r);
+            else
+            {
+                if (c.lhs.is_fluent)
+                    add_reader(m_fluent_readers, c.lhs.fluent, r);
+                if (c.rhs.is_fluent)
+                    add_reader(m_fluent_readers, c.rhs.fluent, r);
+            }
+        }
+    }
+
+    // Stratify: a head is at least at the level of the derived atoms it reads
+    // positively, and strictly above those it reads negatively.  Levels only
+    // grow, and exceed the number of derived atoms iff there is a negative cycle.
+    auto is_derived = [&](AtomId atom) { return atom < m_head_rules.size() && !m_head_rules[atom].empty(); };
+    const auto heads = static_cast<std::uint32_t>(std::count_if(m_head_rules.begin(), m_head_rules.end(),
+                                                                [](const auto& rules) { return !rules.empty(); }));
+    std::vector<std::uint32_t> level(m_head_rules.size(), 0);
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (const auto& gdp : derived)
+        {
+            for (const auto& c : gdp.conditions)
+            {
+                if (c.kind == GroundCondition::Kind::Compare || !is_derived(c.atom))
+                    continue;
+                const std::uint32_t need = level[c.atom] + (c.kind == GroundCondition::Kind::NotFact ? 1 : 0);
+                if (level[gdp.head] < need)
+                {
+                    level[gdp.head] = need;
+                    changed = true;
+                    if (need > heads)
+                        throw std::runtime_error("derived predicates are not stratifiable (negation cycle)");
+                }
+            }
+        }
+    }
+    for (std::uint32_t r = 0; r < derived.size(); ++r)
+        m_stratum[r] = level[derived[r].head];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DerivedEvaluator::mark(std::uint32_t r)
+{
+    if (m_epoch_of[r] != m_epoch)
+    {
+        m_epoch_of[r] = m_epoch;
+        m_cone.push_back(r);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DerivedEvaluator::evaluate(WorldState& ws)
+{
+    if (empty())
+        return;
+    if (++m_epoch == 0)
+    {
+        std::fill(m_epoch_of.begin(), m_epoch_of.end(), 0);
+        m_epoch = 1;
+    }
+    m_cone.clear();
+    for (std::uint32_t r = 0; r < m_derived->size(); ++r)
+        mark(r);
+    recompute(ws);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DerivedEvaluator::apply(const GroundAction& action, WorldState& ws, UndoLog* undo)
+{
+    if (undo)
+    {
+        undo->atoms.clear();
+        undo->fluents.clear();
+        for (const auto& eff : action.effects)
+        {
+            if (eff.kind == GroundEffect::Kind::Numeric)
+                undo->fluents.emplace_back(eff.fluent, ws.get_fluent(eff.fluent));
+            else
+                undo->atoms.emplace_back(eff.atom, ws.holds(eff.atom));
+        }
+    }
+    if (empty())
+    {
+        execute(action.effect_code, ws);
+        return;
+    }
+
+    m_old_atoms.clear();
+    m_old_fluents.clear();
+    for (const auto& eff : action.effects)
+    {
+        if (eff.kind == GroundEffect::Kind::Numeric)
+            m_old_fluents.emplace_back(eff.fluent, ws.get_fluent(eff.fluent));
+        else
+            m_old_atoms.emplace_back(eff.atom, ws.holds(eff.atom));
+    }
+
+    execute(action.effect_code, ws);
+
+    m_changed_atoms.clear();
+    m_changed_fluents.clear();
+    for (const auto& [atom, value] : m_old_atoms)
+        if (ws.holds(atom) != value)
+            m_changed_atoms.push_back(atom);
+    for (const auto& [fluent, value] : m_old_fluents)
+        if (ws.get_fluent(fluent) != value)
+            m_changed_fluents.push_back(fluent);
+    update(ws, undo);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DerivedEvaluator::revert(const UndoLog& undo, WorldState& ws)
+{
+    // Reverse order: an entry logged twice ends with its oldest value.
+    for (auto it = undo.atoms.rbegin(); it != undo.atoms.rend(); ++it)
+    {
+        if (it->second)
+            ws.add(it->first);
+        else
+            ws.remove(it->first);
+    }
+    for (auto it = undo.fluents.rbegin(); it != undo.fluents.rend(); ++it)
+        ws.set_fluent(it->first, it->second);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DerivedEvaluator::update(WorldState& ws, UndoLog* undo)
+{
+    if (m_changed_atoms.empty() && m_changed_fluents.empty())
+        return;
+    if (++m_epoch == 0)
+    {
+        std::fill(m_epoch_of.begin(), m_epoch_of.end(), 0);
+        m_epoch = 1;
+    }
+    m_cone.clear();
+
+    for (auto atom : m_changed_atoms)
+        if (atom < m_atom_readers.size())
+            for (auto r : m_atom_readers[atom])
+                mark(r);
+    for (auto fluent : m_changed_fluents)
+        if (fluent < m_fluent_readers.size())
+            for (auto r : m_fluent_readers[fluent])
+                mark(r);
+
+    // Close the cone: a recomputed head may change, which affects its readers,
+    // and resetting a head requires all of its rules.
+    for (size_t i = 0; i < m_cone.size(); ++i)
+    {
+        const AtomId head = (*m_derived)[m_cone[i]].head;
+        for (auto r : m_head_rules[head])
+            mark(r);
+        if (head < m_atom_readers.size())
+            for (auto r : m_atom_readers[head])
+                mark(r);
+    }
+
+    if (m_cone.empty())
+        return;
+    if (undo)
+        for (auto r : m_cone)
+            undo->atoms.emplace_back((*m_derived)[r].head, ws.holds((*m_derived)[r].head));
+    recompute(ws);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DerivedEvaluator::recompute(WorldState& ws)
+{
+    const auto& derived = *m_derived;
+    std::sort(m_cone.begin(), m_cone.end(),
+              [&](std::uint32_t x, std::uint32_t y) { return std::tie(m_stratum[x], x) < std::tie(m_stratum[y], y); });
+
+    // A fact condition is recursive when it reads a head recomputed in the same stratum.
+    auto recursive = [&](const GroundCondition& c, std::uint32_t stratum)
+    {
+        if (c.kind != GroundCondition::Kind::Fact || c.atom >= m_head_rules.size() || m_head_rules[c.atom].empty())
+            return false;
+        const std::uint32_t r = m_head_rules[c.atom].front();
+        return m_epoch_of[r] == m_epoch && m_stratum[r] == stratum;
+    };
+
+    std::vector<std::uint32_t> ready;
+    for (size_t begin = 0; begin < m_cone.size();)
+    {
+        const std::uint32_t stratum = m_stratum[m_cone[begin]];
+        size_t end = begin;
+        while (end < m_cone.size() && m_stratum[m_cone[end]] == stratum)
+            ++end;
+
+        for (size_t i = begin; i < end; ++i)
+            ws.remove(derived[m_cone[i]].head);
+
+        // Lower strata are final, so only recursive conditions are left open.
+        ready.clear();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const std::uint32_t r = m_cone[i];
+            std::uint32_t missing = 0;
+            for (const auto& c : derived[r].conditions)
+            {
+                if (recursive(c, stratum))
+                    ++missing;
+                else if (!ws.evaluates(c))
+                {
+                    missing = DEAD;
+                    break;
+                }
+            }
+            m_missing[r] = missing;
+            if (missing == 0)
+                ready.push_back(r);
+        }
+
+        while (!ready.empty())
+        {
+            const AtomId head = derived[ready.back()].head;
+            ready.pop_back();
+            if (ws.holds(head))
+                continue;
+            ws.add(head);
+            if (head >= m_atom_readers.size())
+                continue;
+            for (auto q : m_atom_readers[head])
+            {
+                if (m_epoch_of[q] != m_epoch || m_stratum[q] != stratum || m_missing[q] == DEAD)
+                    continue;
+                for (const auto& c : derived[q].conditions)
+                    if (c.kind == GroundCondition::Kind::Fact && c.atom == head && --m_missing[q] == 0)
+                        ready.push_back(q);
+            }
+        }
+        begin = end;
+    }
+}
+
+} // namespace pddl::solver
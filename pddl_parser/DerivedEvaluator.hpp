@@ -0,0 +1,91 @@
+/// @file DerivedEvaluator.hpp
+/// Stratified, incremental evaluation of ground derived predicates.
+#pragma once
+
+#include "ISolver.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Evaluator of ground derived predicates (axioms).
+///
+/// A derived atom is true iff one of its rules holds, computed as the least
+/// fixpoint of the rules.  Rules are stratified: a rule reading a derived atom
+/// negatively is evaluated in a later stratum than the rules defining it, so
+/// each stratum is a monotone fixpoint computed in one pass with per-rule
+/// counters of unsatisfied conditions.
+///
+/// After an action, only the rules reading an atom or fluent the action
+/// actually changed are re-evaluated, together with the rules depending on
+/// their heads (transitively) and the other rules sharing those heads.
+///
+/// The evaluator keeps scratch buffers, so a single instance must not be used
+/// by several threads at once.  The rules must outlive the evaluator.
+/// *****************************************************************************
+class DerivedEvaluator
+{
+public:
+
+    /// @throws std::runtime_error if the rules are not stratifiable (a derived
+    ///         atom depends negatively on itself).
+    explicit DerivedEvaluator(const std::vector<GroundDerivedPredicate>& derived);
+
+    /// True if there are no rules to evaluate.
+    bool empty() const
+    {
+        return m_derived->empty();
+    }
+
+    /// Recompute every derived atom of @p ws from scratch.
+    void evaluate(WorldState& ws);
+
+    /// Values overwritten by one apply(), enough to restore the previous state.
+    struct UndoLog
+    {
+        std::vector<std::pair<AtomId, bool>>     atoms;   ///< Atom values, in overwrite order.
+        std::vector<std::pair<FluentId, double>> fluents; ///< Fluent values, in overwrite order.
+    };
+
+    /// Execute the effects of @p action on @p ws and update the derived atoms
+    /// depending on what the effects changed.  When @p undo is set, it receives
+    /// what revert() needs to restore @p ws.
+    void apply(const GroundAction& action, WorldState& ws, UndoLog* undo = nullptr);
+
+    /// Restore the state @p ws had before the apply() that filled @p undo.
+    static void revert(const UndoLog& undo, WorldState& ws);
+
+private:
+
+    /// Re-evaluate the rules affected by @c m_changed_atoms / @c m_changed_fluents,
+    /// logging the old values of the recomputed heads in @p undo if set.
+    void update(WorldState& ws, UndoLog* undo);
+
+    /// Recompute the heads of the rules marked in @c m_cone, stratum by stratum.
+    void recompute(WorldState& ws);
+
+    /// Add rule @p r to the cone being collected.
+    void mark(std::uint32_t r);
+
+private:
+
+    const std::vector<GroundDerivedPredicate>* m_derived;     ///< The rules.
+    std::vector<std::uint32_t> m_stratum;                     ///< Stratum of each rule.
+    std::vector<std::vector<std::uint32_t>> m_atom_readers;   ///< Rules with a fact condition on each atom.
+    std::vector<std::vector<std::uint32_t>> m_fluent_readers; ///< Rules comparing each fluent.
+    std::vector<std::vector<std::uint32_t>> m_head_rules;     ///< Rules defining each derived atom.
+
+    // Scratch.
+    std::vector<std::uint32_t> m_epoch_of;     ///< Cone membership: rule r is in the cone iff m_epoch_of[r] == m_epoch.
+    std::uint32_t m_epoch = 0;                 ///< Current cone stamp.
+    std::vector<std::uint32_t> m_cone;         ///< Rules to recompute.
+    std::vector<std::uint32_t> m_missing;      ///< Unsatisfied same-stratum conditions per rule.
+    std::vector<AtomId> m_changed_atoms;       ///< Atoms changed by the last action.
+    std::vector<FluentId> m_changed_fluents;   ///< Fluents changed by the last action.
+    std::vector<std::pair<AtomId, bool>> m_old_atoms;       ///< Atom values before the last action.
+    std::vector<std::pair<FluentId, double>> m_old_fluents; ///< Fluent values before the last action.
+};
+
+} // namespace pddl::solver
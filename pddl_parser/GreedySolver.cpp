@@ -0,0 +1,235 @@
+#include "GreedySolver.hpp"
+#include "AStarSolver.hpp"
+#include "ClosedList.hpp"
+#include "RelaxedHeuristic.hpp"
+#include "SuccessorGenerator.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Deferred successor: the action to apply to an expanded state.
+/// *****************************************************************************
+struct LazyEntry
+{
+    std::uint32_t parent = 0; ///< Arena record of the expanded parent.
+    std::uint32_t action = 0; ///< Ground action leading to the successor.
+};
+
+/// *****************************************************************************
+/// Queue of deferred successors, lowest estimate first and oldest first on
+/// ties, backed by a binary heap or a bucket queue (see GreedyConfig::open_list).
+/// Like OpenList, a bucket queue turns into a heap, for the rest of the search,
+/// when an estimate is too large for buckets.
+/// *****************************************************************************
+class LazyQueue
+{
+public:
+
+    /// Queued successor.
+    struct Entry
+    {
+        float h;           ///< Estimate of the parent.
+        std::uint64_t seq; ///< Insertion number, for the heap's FIFO ties.
+        LazyEntry entry;   ///< Deferred successor.
+    };
+
+    explicit LazyQueue(OpenListKind kind) : m_kind(kind), m_buckets(InsertionOrder::Fifo) {}
+
+    /// True if nothing is queued.
+    bool empty() const
+    {
+        return m_kind == OpenListKind::Buckets ? m_buckets.empty() : m_heap.empty();
+    }
+
+    /// Number of queued successors.
+    size_t size() const
+    {
+        return m_kind == OpenListKind::Buckets ? m_buckets.size() : m_heap.size();
+    }
+
+    /// Queue @p entry at estimate @p h.
+    void push(float h, LazyEntry entry)
+    {
+        const Entry queued{ h, m_seq++, entry };
+        if (m_kind == OpenListKind::Buckets)
+        {
+            const size_t key = bucket_key(h);
+            if (BucketQueue<Entry>::fits(key))
+            {
+                m_buckets.push(key, 0, queued);
+                return;
+            }
+            m_kind = OpenListKind::BinaryHeap;
+            while (!m_buckets.empty())
+                push_heap(m_buckets.pop());
+            m_buckets = BucketQueue<Entry>(InsertionOrder::Fifo);
+        }
+        push_heap(queued);
+    }
+
+    /// Remove and return the best successor (the queue must not be empty).
+    LazyEntry pop()
+    {
+        if (m_kind == OpenListKind::Buckets)
+            return m_buckets.pop().entry;
+        std::pop_heap(m_heap.begin(), m_heap.end(), after);
+        const LazyEntry entry = m_heap.back().entry;
+        m_heap.pop_back();
+        return entry;
+    }
+
+private:
+
+    /// Heap order: true if @p a comes after @p b.
+    static bool after(const Entry& a, const Entry& b)
+    {
+        return a.h != b.h ? a.h > b.h : a.seq > b.seq;
+    }
+
+    void push_heap(const Entry& queued)
+    {
+        m_heap.push_back(queued);
+        std::push_heap(m_heap.begin(), m_heap.end(), after);
+    }
+
+private:
+
+    OpenListKind       m_kind;    ///< Backing structure.
+    std::vector<Entry> m_heap;    ///< Binary heap under after().
+    BucketQueue<Entry> m_buckets; ///< Bucket queue, keyed by the rounded-up estimate.
+    std::uint64_t      m_seq = 0; ///< Next insertion number.
+};
+
+/// *****************************************************************************
+/// ISolver::solve implementation
+/// *****************************************************************************
+PlanResult GreedyBestFirstSolver::solve(const SolverContext& ctx)
+{
+    const auto& initial = ctx.initial;
+    const auto& actions = ctx.actions;
+    const auto& goals = ctx.goals;
+    const auto& cfg = m_config;
+
+    std::unique_ptr<IHeuristic> heuristic = make_heuristic(cfg.heuristic_kind, ctx);
+    auto* relaxed = cfg.preferred_operators ? dynamic_cast<RelaxedHeuristic*>(heuristic.get()) : nullptr;
+
+    // Expanded nodes: parent links, states and costs, indexed by arena record.
+    std::vector<SearchNode> arena;
+    std::vector<WorldState> states;
+    std::vector<float> costs;
+    ClosedList visited(std::max(ctx.atoms.atom_count(), initial.get_words().size() * WorldState::WORD_BITS),
+                       std::max(ctx.atoms.fluent_count(), initial.get_fluents().size()),
+                       cfg.fluent_bucket_size);
+
+    // Both queues are keyed by the estimate of the parent.
+    LazyQueue regular(cfg.open_list);
+    LazyQueue preferred(cfg.open_list);
+    int regular_priority = 0;
+    int preferred_priority = 0;
+
+    const SuccessorGenerator successors(actions);
+    DerivedEvaluator axioms(ctx.derived);
+    std::vector<std::uint32_t> candidates;
+
+    auto finish = [&](std::uint32_t record, size_t iterations)
+    {
+        if (cfg.verbose)
+            std::cerr << "[gbfs] Goal reached after " << iterations << " iterations\n";
+        PlanResult result;
+        result.success = true;
+        result.plan = reconstruct_plan(arena, actions, record);
+        result.final_state = states[record];
+        result.iterations = iterations;
+        result.cost = costs[record];
+        return result;
+    };
+
+    // Queue the applicable actions of expanded record @p record, estimated at @p h.
+    auto expand = [&](std::uint32_t record, float h)
+    {
+        const WorldState& ws = states[record];
+        successors.generate(ws, candidates);
+        for (auto a : candidates)
+        {
+            if (!AStarSolver::is_applicable(actions[a], ws))
+                continue;
+            regular.push(h, { record, a });
+            if (relaxed && std::binary_search(relaxed->helpful_actions().begin(), relaxed->helpful_actions().end(), a))
+                preferred.push(h, { record, a });
+        }
+    };
+
+    arena.push_back({ NO_PARENT, 0 });
+    states.push_back(initial);
+    states.back().set_hash_bucket(cfg.fluent_bucket_size); // Successors inherit the bucket size.
+    costs.push_back(0);
+    visited.assign(states.back(), 0);
+    if (initial.is_goal_reached(goals))
+        return finish(0, 0);
+
+    float best_h = heuristic->evaluate(initial);
+    if (best_h != DEAD_END)
+        expand(0, best_h);
+
+    size_t iterations = 0;
+    StopCondition limits(ctx, cfg.max_iterations);
+    ProgressReporter progress(ctx);
+    while ((!regular.empty() || !preferred.empty()) && !limits(iterations))
+    {
+        ++iterations;
+        const bool use_preferred = !preferred.empty() && (regular.empty() || preferred_priority >= regular_priority);
+        const LazyEntry entry = use_preferred ? preferred.pop() : regular.pop();
+        if (use_preferred)
+            --preferred_priority;
+        else
+            --regular_priority;
+
+        const auto& action = actions[entry.action];
+        WorldState ws = AStarSolver::apply_action(action, states[entry.parent], axioms);
+        if (visited.find(ws))
+            continue;
+
+        const auto record = static_cast<std::uint32_t>(arena.size());
+        const float g = costs[entry.parent] + static_cast<float>(action.cost);
+        visited.assign(ws, g);
+        arena.push_back({ entry.parent, entry.action });
+        states.push_back(std::move(ws));
+        costs.push_back(g);
+
+        if (states[record].is_goal_reached(goals))
+            return finish(record, iterations);
+
+        // Deferred evaluation: once per expanded state.
+        const float h = heuristic->evaluate(states[record]);
+        if (h == DEAD_END)
+            continue;
+        if (h < best_h)
+        {
+            best_h = h;
+            preferred_priority += cfg.preferred_boost;
+        }
+        expand(record, h);
+
+        if (progress.due(iterations))
+        {
+            const size_t queued = regular.size() + preferred.size();
+            progress({ iterations, queued, best_h,
+                       queued * sizeof(LazyQueue::Entry) + states.capacity() * node_bytes(initial) +
+                           arena.capacity() * (sizeof(SearchNode) + sizeof(float)) + visited.memory_bytes() });
+        }
+    }
+
+    PlanResult result;
+    result.final_state = initial;
+    result.iterations = iterations;
+    result.stop_reason = regular.empty() && preferred.empty() ? StopReason::Exhausted : limits.reason();
+    if (cfg.verbose)
+        std::cerr << "[gbfs] No plan found after " << iterations << " iterations ("
+                  << stop_reason_name(result.stop_reason) << ")\n";
+    return result;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,59 @@
+/// @file GreedySolver.hpp
+/// Greedy best-first planner with deferred evaluation and preferred operators.
+#pragma once
+
+#include "Heuristic.hpp"
+#include "ISolver.hpp"
+#include "OpenList.hpp"
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Configuration for the greedy best-first planner.
+/// *****************************************************************************
+struct GreedyConfig
+{
+    size_t max_iterations = 500'000; ///< Maximum number of expansions.
+    int fluent_bucket_size = 10;     ///< Granularity for state hashing (0 = exact).
+    bool verbose = false;            ///< Print debug info during search.
+
+    /// Heuristic; preferred operators need a delete-relaxation one (hmax, hadd, hff).
+    HeuristicKind heuristic_kind = HeuristicKind::HFF;
+
+    bool preferred_operators = true; ///< Keep a second queue of successors by helpful actions.
+    int preferred_boost = 1000;      ///< Extra pops granted to the preferred queue on progress.
+
+    /// Queue structure; buckets key on the rounded-up estimate and suit small integral ones.
+    OpenListKind open_list = OpenListKind::BinaryHeap;
+};
+
+/// *****************************************************************************
+/// Greedy best-first search (GBFS) with deferred evaluation.
+///
+/// Successors are queued with the estimate of their parent and only built and
+/// evaluated when popped, so the heuristic runs once per expanded state rather
+/// than once per generated state; goal tests happen before the evaluation.
+/// Queues pop the lowest estimate first and the oldest successor on ties.
+/// Plans are found fast but carry no optimality guarantee.
+///
+/// With preferred operators, successors reached by a helpful action of the
+/// relaxed plan (RelaxedHeuristic::helpful_actions()) also enter a preferred
+/// queue.  The two queues are popped alternately, and the preferred one gets
+/// @c preferred_boost extra turns whenever a new best estimate is reached.
+/// *****************************************************************************
+class GreedyBestFirstSolver: public ISolver
+{
+public:
+
+    explicit GreedyBestFirstSolver(GreedyConfig cfg = {}) : m_config(std::move(cfg)) {}
+
+    /// @copydoc ISolver::solve
+    PlanResult solve(const SolverContext& ctx) override;
+
+private:
+
+    GreedyConfig m_config;
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,305 @@
+#include "HdaStarSolver.hpp"
+#include "AStarSolver.hpp"
+#include "ClosedList.hpp"
+#include "SuccessorGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Reference to a node in the arena of one worker.
+/// *****************************************************************************
+struct NodeRef
+{
+    std::uint32_t worker = UINT32_MAX; ///< Owning worker (UINT32_MAX: parent of the root).
+    std::uint32_t index = 0;           ///< Record in the worker's arena.
+};
+
+/// *****************************************************************************
+/// Search-tree record of HDA*: parent links may cross workers.
+/// *****************************************************************************
+struct HdaRecord
+{
+    NodeRef parent;           ///< Parent node.
+    std::uint32_t action = 0; ///< Ground action applied to the parent.
+};
+
+/// *****************************************************************************
+/// Generated successor sent to the worker owning its state.
+/// *****************************************************************************
+struct HdaMessage
+{
+    WorldState state;         ///< Successor state.
+    float g = 0;              ///< Cost of the path to it.
+    NodeRef parent;           ///< Expanded parent.
+    std::uint32_t action = 0; ///< Action from the parent.
+};
+
+/// *****************************************************************************
+/// Lock-free multi-producer inbox: producers push with a CAS on the head, the
+/// single consumer takes the whole list at once.
+/// *****************************************************************************
+template <class T>
+class MpscInbox
+{
+public:
+
+    struct Item
+    {
+        T value;
+        Item* next;
+    };
+
+    MpscInbox() = default;
+    MpscInbox(const MpscInbox&) = delete;
+    MpscInbox& operator=(const MpscInbox&) = delete;
+
+    ~MpscInbox()
+    {
+        for (Item* item = take_all(); item;)
+            item = release(item);
+    }
+
+    /// Add @p value (any thread).
+    void push(T value)
+    {
+        Item* item = new Item{ std::move(value), m_head.load(std::memory_order_relaxed) };
+        while (!m_head.compare_exchange_weak(item->next, item, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// Detach every queued item, newest first (consumer thread only).
+    Item* take_all()
+    {
+        return m_head.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    /// Free @p item and return the next one.
+    static Item* release(Item* item)
+    {
+        Item* next = item->next;
+        delete item;
+        return next;
+    }
+
+private:
+
+    std::atomic<Item*> m_head{ nullptr };
+};
+
+using HdaBatch = std::vector<HdaMessage>;
+
+/// *****************************************************************************
+/// Per-worker data visible to the other workers and to the final plan rebuild.
+/// *****************************************************************************
+struct HdaWorker
+{
+    MpscInbox<HdaBatch> inbox;     ///< Successors sent by the workers.
+    std::vector<HdaRecord> arena;  ///< Records of the nodes opened by this worker.
+    size_t expansions = 0;         ///< Nodes expanded by this worker.
+};
+
+/// *****************************************************************************
+/// ISolver::solve implementation
+/// *****************************************************************************
+PlanResult HdaStarSolver::solve(const SolverContext& ctx)
+{
+    const auto& actions = ctx.actions;
+    const auto& goals = ctx.goals;
+    const auto& cfg = m_config;
+
+    const size_t n = cfg.threads ? cfg.threads : std::max(1u, std::thread::hardware_concurrency());
+    const size_t atom_count = std::max(ctx.atoms.atom_count(), ctx.initial.get_words().size() * WorldState::WORD_BITS);
+    const size_t fluent_count = std::max(ctx.atoms.fluent_count(), ctx.initial.get_fluents().size());
+    const SuccessorGenerator successors(actions);
+    auto owner = [&](const WorldState& ws) { return static_cast<std::uint32_t>(mix64(ws.hash()) % n); };
+
+    std::vector<HdaWorker> workers(n);
+    std::atomic<bool> done{ false };
+    std::atomic<std::int64_t> in_flight{ 0 }; ///< Batches sent and not yet processed.
+    std::atomic<size_t> expansions{ 0 };
+    std::mutex idle_mutex;             ///< Guards @c idle, @c stopped and the end of the search.
+    size_t idle = 0;                   ///< Workers with nothing to do.
+    std::optional<StopReason> stopped; ///< Limit that ended the search, if any.
+
+    std::mutex goal_mutex;
+    std::atomic<float> incumbent{ std::numeric_limits<float>::infinity() };
+    NodeRef goal;
+    WorldState goal_state;
+
+    auto work = [&](std::uint32_t w)
+    {
+        HdaWorker& self = workers[w];
+        std::unique_ptr<IHeuristic> heuristic = make_heuristic(cfg.heuristic_kind, ctx);
+        DerivedEvaluator axioms(ctx.derived);
+        ClosedList best_cost(atom_count, fluent_count, cfg.fluent_bucket_size);
+        OpenList open(OpenListKind::BinaryHeap, TieBreaking::None, InsertionOrder::Lifo);
+        std::vector<HdaBatch> outbox(n);
+        std::vector<std::uint32_t> candidates;
+        bool busy = true;
+        StopCondition limits(ctx, cfg.max_iterations);
+
+        auto receive = [&](HdaMessage& msg)
+        {
+            if (const float* g = best_cost.find(msg.state); g && *g <= msg.g)
+                return;
+            const float h = heuristic->evaluate(msg.state);
+            if (h == DEAD_END || msg.g + h >= incumbent.load(std::memory_order_relaxed))
+                return;
+            Node node;
+            node.real_cost = msg.g;
+            node.heuristic = h;
+            node.estimated_cost = msg.g + h;
+            node.state = std::move(msg.state);
+            node.record = self.arena.size();
+            self.arena.push_back({ msg.parent, msg.action });
+            open.push(std::move(node));
+        };
+
+        while (!done.load(std::memory_order_acquire))
+        {
+            if (limits(expansions.load(std::memory_order_relaxed)))
+            {
+                std::lock_guard lock(idle_mutex);
+                if (!done.load())
+                    stopped = limits.reason();
+                done.store(true, std::memory_order_release);
+                break;
+            }
+
+            if (auto* item = self.inbox.take_all())
+            {
+                if (!busy)
+                {
+                    std::lock_guard lock(idle_mutex);
+                    --idle;
+                    busy = true;
+                }
+                std::int64_t batches = 0;
+                for (; item; item = MpscInbox<HdaBatch>::release(item), ++batches)
+                    for (auto& msg : item->value)
+                        receive(msg);
+                in_flight.fetch_sub(batches, std::memory_order_acq_rel);
+            }
+
+            // Expand the best open node that can still beat the incumbent.
+            bool expanded = false;
+            while (!open.empty() && !expanded)
+            {
+                Node current = open.pop();
+                if (current.estimated_cost >= incumbent.load(std::memory_order_relaxed))
+                    continue;
+                if (const float* g = best_cost.find(current.state); g && *g <= current.real_cost)
+                    continue;
+                best_cost.assign(current.state, current.real_cost);
+
+                const NodeRef ref{ w, static_cast<std::uint32_t>(current.record) };
+                if (current.state.is_goal_reached(goals))
+                {
+                    std::lock_guard lock(goal_mutex);
+                    if (current.real_cost < incumbent.load())
+                    {
+                        incumbent.store(current.real_cost);
+                        goal = ref;
+                        goal_state = current.state;
+                    }
+                    continue;
+                }
+
+                expanded = true;
+                ++self.expansions;
+                expansions.fetch_add(1, std::memory_order_relaxed);
+
+                successors.generate(current.state, candidates);
+                for (auto a : candidates)
+                {
+                    const auto& action = actions[a];
+                    if (!AStarSolver::is_applicable(action, current.state))
+                        continue;
+                    HdaMessage msg{ AStarSolver::apply_action(action, current.state, axioms),
+                                    current.real_cost + static_cast<float>(action.cost), ref, a };
+                    const std::uint32_t to = owner(msg.state);
+                    if (to == w)
+                        receive(msg);
+                    else
+                        outbox[to].push_back(std::move(msg));
+                }
+                for (std::uint32_t to = 0; to < n; ++to)
+                {
+                    if (outbox[to].empty())
+                        continue;
+                    in_flight.fetch_add(1, std::memory_order_acq_rel);
+                    workers[to].inbox.push(std::move(outbox[to]));
+                    outbox[to] = {};
+                }
+            }
+
+            if (expanded)
+                continue;
+            if (busy)
+            {
+                // Nothing useful left here; the search is over once everyone agrees and nothing is in flight.
+                std::lock_guard lock(idle_mutex);
+                busy = false;
+                if (++idle == n && in_flight.load(std::memory_order_acquire) == 0)
+                    done.store(true, std::memory_order_release);
+            }
+            else
+                std::this_thread::yield();
+        }
+    };
+
+    // The root is sent to its owner like any other node.
+    WorldState root = ctx.initial;
+    root.set_hash_bucket(cfg.fluent_bucket_size); // Successors inherit the bucket size.
+    const std::uint32_t root_owner = owner(root);
+    in_flight.store(1);
+    workers[root_owner].inbox.push(HdaBatch{ HdaMessage{ std::move(root), 0, NodeRef{}, 0 } });
+
+    std::vector<std::thread> threads;
+    for (std::uint32_t w = 0; w < n; ++w)
+        threads.emplace_back(work, w);
+    for (auto& t : threads)
+        t.join();
+
+    if (cfg.verbose)
+    {
+        std::cerr << "[hda*] " << expansions.load() << " expansions:";
+        for (const auto& worker : workers)
+            std::cerr << " " << worker.expansions;
+        std::cerr << "\n";
+    }
+
+    if (incumbent.load() == std::numeric_limits<float>::infinity())
+    {
+        PlanResult result;
+        result.final_state = ctx.initial;
+        result.iterations = expansions.load();
+        result.stop_reason = stopped.value_or(StopReason::Exhausted);
+        return result;
+    }
+
+    PlanResult result;
+    result.success = true;
+    result.final_state = goal_state;
+    result.iterations = expansions.load();
+    result.cost = incumbent.load();
+    result.stop_reason = stopped.value_or(StopReason::Solved);
+    for (NodeRef ref = goal; ref.worker != UINT32_MAX;)
+    {
+        const HdaRecord& record = workers[ref.worker].arena[ref.index];
+        if (record.parent.worker != UINT32_MAX)
+            result.plan.push_back(actions[record.action].name);
+        ref = record.parent;
+    }
+    std::reverse(result.plan.begin(), result.plan.end());
+    return result;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,54 @@
+/// @file HdaStarSolver.hpp
+/// Hash-distributed parallel A* planner.
+#pragma once
+
+#include "Heuristic.hpp"
+#include "ISolver.hpp"
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Configuration for the HDA* planner.
+/// *****************************************************************************
+struct HdaConfig
+{
+    size_t threads = 0;              ///< Worker threads (0 = hardware concurrency).
+    size_t max_iterations = 500'000; ///< Maximum number of expansions over all workers.
+    int fluent_bucket_size = 10;     ///< Granularity for state hashing (0 = exact).
+    bool verbose = false;            ///< Print debug info during search.
+
+    /// Built-in heuristic, one instance per worker (admissible for optimal plans).
+    HeuristicKind heuristic_kind = HeuristicKind::GoalCount;
+};
+
+/// *****************************************************************************
+/// Hash-distributed A* (Kishimoto, Fukunaga & Botea).
+///
+/// Every state is owned by one worker, chosen from its Zobrist hash; each
+/// worker keeps its own open list, closed list and node arena and only
+/// expands the states it owns.  Successors are sent to their owner through
+/// lock-free inboxes, in one batch per destination and expansion, and
+/// evaluated by the receiver, so heuristic work is spread as well.
+///
+/// A goal popped by any worker becomes the incumbent; nodes with
+/// f >= incumbent are dropped.  The search ends when every worker is idle and
+/// no batch is in flight (checked under a mutex taken only on idle / busy
+/// transitions), at which point no open node can beat the incumbent and,
+/// with an admissible heuristic, the plan is optimal.
+/// *****************************************************************************
+class HdaStarSolver: public ISolver
+{
+public:
+
+    explicit HdaStarSolver(HdaConfig cfg = {}) : m_config(std::move(cfg)) {}
+
+    /// @copydoc ISolver::solve
+    PlanResult solve(const SolverContext& ctx) override;
+
+private:
+
+    HdaConfig m_config;
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,83 @@
+#include "Heuristic.hpp"
+#include "Landmarks.hpp"
+#include "LmCutHeuristic.hpp"
+#include "NumericBoundHeuristic.hpp"
+#include "PatternDatabase.hpp"
+#include "RelaxedHeuristic.hpp"
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Number of unsatisfied goal conditions.
+/// *****************************************************************************
+class GoalCountHeuristic: public IHeuristic
+{
+public:
+
+    explicit GoalCountHeuristic(const std::vector<GroundCondition>& goals) : m_goals(goals) {}
+
+    float evaluate(const WorldState& ws) override
+    {
+        float count = 0;
+        for (const auto& g : m_goals)
+        {
+            if (!ws.evaluates(g))
+                ++count;
+        }
+        return count;
+    }
+
+private:
+
+    const std::vector<GroundCondition>& m_goals;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+std::optional<HeuristicKind> heuristic_kind_from_string(std::string_view name)
+{
+    if (name == "goalcount")
+        return HeuristicKind::GoalCount;
+    if (name == "hmax")
+        return HeuristicKind::HMax;
+    if (name == "hadd")
+        return HeuristicKind::HAdd;
+    if (name == "hff")
+        return HeuristicKind::HFF;
+    if (name == "numeric")
+        return HeuristicKind::Numeric;
+    if (name == "lmcount")
+        return HeuristicKind::LmCount;
+    if (name == "lmcut")
+        return HeuristicKind::LmCut;
+    if (name == "pdb")
+        return HeuristicKind::Pdb;
+    return std::nullopt;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::unique_ptr<IHeuristic> make_heuristic(HeuristicKind kind, const SolverContext& ctx)
+{
+    switch (kind)
+    {
+        case HeuristicKind::GoalCount:
+            return std::make_unique<GoalCountHeuristic>(ctx.goals);
+        case HeuristicKind::HMax:
+            return std::make_unique<RelaxedHeuristic>(ctx, RelaxedHeuristic::Mode::Max);
+        case HeuristicKind::HAdd:
+            return std::make_unique<RelaxedHeuristic>(ctx, RelaxedHeuristic::Mode::Add);
+        case HeuristicKind::HFF:
+            return std::make_unique<RelaxedHeuristic>(ctx, RelaxedHeuristic::Mode::FF);
+        case HeuristicKind::Numeric:
+            return std::make_unique<NumericBoundHeuristic>(ctx);
+        case HeuristicKind::LmCount:
+            return std::make_unique<LandmarkCountHeuristic>(ctx);
+        case HeuristicKind::LmCut:
+            return std::make_unique<LmCutHeuristic>(ctx);
+        case HeuristicKind::Pdb:
+            return std::make_unique<PatternDatabaseHeuristic>(ctx);
+    }
+    return nullptr;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,54 @@
+/// @file Heuristic.hpp
+/// Built-in state heuristics selectable from the solver configurations.
+#pragma once
+
+#include "ISolver.hpp"
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace pddl::solver
+{
+
+/// Estimate returned for states from which the goal is unreachable.
+inline constexpr float DEAD_END = std::numeric_limits<float>::infinity();
+
+/// Built-in heuristics.
+enum class HeuristicKind
+{
+    GoalCount, ///< Number of unsatisfied goal conditions.
+    HMax,      ///< Delete relaxation, cost of the most expensive goal (admissible).
+    HAdd,      ///< Delete relaxation, sum of the goal costs.
+    HFF,       ///< Delete relaxation, cost of an extracted relaxed plan.
+    Numeric,   ///< Goal gaps divided by the best progress rates (admissible).
+    LmCount,   ///< Cost of the landmarks still to reach.
+    LmCut,     ///< LM-cut over the propositional relaxation (admissible).
+    Pdb,       ///< Precomputed pattern database (admissible).
+};
+
+/// Parse a heuristic name: "goalcount", "hmax", "hadd", "hff", "numeric",
+/// "lmcount", "lmcut" or "pdb".
+std::optional<HeuristicKind> heuristic_kind_from_string(std::string_view name);
+
+/// *****************************************************************************
+/// Goal-distance estimator used by the search algorithms.
+///
+/// Heuristics may keep scratch buffers between calls, so an instance must not
+/// be shared between threads; create one per search thread instead.
+/// *****************************************************************************
+class IHeuristic
+{
+public:
+
+    virtual ~IHeuristic() = default;
+
+    /// Estimated cost from @p ws to the goal, or DEAD_END.
+    virtual float evaluate(const WorldState& ws) = 0;
+};
+
+/// Create the built-in heuristic @p kind for the task of @p ctx.
+/// The heuristic references the task, which must outlive it.
+std::unique_ptr<IHeuristic> make_heuristic(HeuristicKind kind, const SolverContext& ctx);
+
+} // namespace pddl::solver
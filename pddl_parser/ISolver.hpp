@@ -6,21 +6,65 @@
 #pragma once
 
 #include "AST.hpp"
+#include "Bytecode.hpp"
+#include "WorldState.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <string>
 #include <vector>
 
 namespace pddl::solver
 {
 
+/// *****************************************************************************
+/// A ground effect: adds or deletes an atom, or mutates a numeric fluent.
+///
+/// When @c when is set this is a PDDL @c (when condition consequent): the
+/// effect applies only when the condition holds.  Effects are applied in
+/// order and each guard is evaluated against the state updated by the
+/// preceding effects of the same action (see execute()), not against the
+/// state before the action as in PDDL.
+/// *****************************************************************************
+struct GroundEffect
+{
+    /// Kind of state change performed by the effect.
+    enum class Kind { Add, Delete, Numeric };
+
+    Kind                           kind   = Kind::Add;              ///< Kind of change.
+    AtomId                         atom   = 0;                      ///< Target atom for Add / Delete.
+    parser::NumericOp              op     = parser::NumericOp::None;///< Mutation for Numeric.
+    FluentId                       fluent = 0;                      ///< Target fluent for Numeric.
+    NumericOperand                 value;                           ///< Operand for Numeric.
+    std::optional<GroundCondition> when;                            ///< Guard of a conditional effect.
+};
+
 /// *****************************************************************************
 /// An instantiated (ground) action with no variables.
+///
+/// @c preconditions and @c effects keep the structured form used for analysis
+/// (heuristics, debug printing); the search executes the compiled programs
+/// @c precondition_code and @c effect_code, filled by compile().
 /// *****************************************************************************
 struct GroundAction
 {
-    std::string name;                             ///< e.g. "work-startup(alice)"
-    int cost = 1;                                 ///< Cost of the action.
-    std::vector<parser::Predicate> preconditions; ///< Instantiated preconditions.
-    std::vector<parser::Effect>    effects;        ///< Instantiated effects.
+    std::string name;                           ///< e.g. "work-startup(alice)"
+    int cost = 1;                               ///< Cost of the action.
+    std::vector<GroundCondition> preconditions; ///< Instantiated preconditions.
+    std::vector<GroundEffect>    effects;       ///< Instantiated effects.
+    Program precondition_code;                  ///< Compiled @c preconditions.
+    Program effect_code;                        ///< Compiled @c effects.
+
+    /// (Re)build @c precondition_code and @c effect_code from the structured form.
+    void compile()
+    {
+        precondition_code = compile_conditions(preconditions);
+        effect_code = compile_effects(effects);
+    }
 };
 
 /// *****************************************************************************
@@ -28,10 +72,51 @@ struct GroundAction
 /// *****************************************************************************
 struct GroundDerivedPredicate
 {
-    parser::Predicate              head;       ///< The predicate being defined.
-    std::vector<parser::Predicate> conditions; ///< Conditions as a conjunction.
+    AtomId                       head = 0;   ///< The atom being defined.
+    std::vector<GroundCondition> conditions; ///< Conditions as a conjunction.
+};
+
+/// *****************************************************************************
+/// A plan found by an anytime search before it finished.
+/// *****************************************************************************
+struct PlanImprovement
+{
+    float  cost       = 0; ///< Cost of the plan.
+    double seconds    = 0; ///< Time since the start of solve().
+    size_t iterations = 0; ///< Iterations spent when it was found.
+};
+
+/// *****************************************************************************
+/// Why a search returned.
+/// *****************************************************************************
+enum class StopReason
+{
+    Solved,         ///< A plan was found (anytime searches: the last one is final).
+    Exhausted,      ///< No open node left: no (better) plan in the explored space.
+    IterationLimit, ///< The configured maximum number of iterations was reached.
+    Deadline,       ///< SolverContext::deadline or a solver time limit passed.
+    Cancelled,      ///< SolverContext::stop was requested.
 };
 
+/// Lower-case name of @p reason, for messages.
+inline const char* stop_reason_name(StopReason reason)
+{
+    switch (reason)
+    {
+        case StopReason::Solved:
+            return "solved";
+        case StopReason::Exhausted:
+            return "exhausted";
+        case StopReason::IterationLimit:
+            return "iteration limit";
+        case StopReason::Deadline:
+            return "deadline";
+        case StopReason::Cancelled:
+            return "cancelled";
+    }
+    return "unknown";
+}
+
 /// *****************************************************************************
 /// Result of a planning search.
 /// *****************************************************************************
@@ -39,8 +124,41 @@ struct PlanResult
 {
     bool success = false;
     std::vector<std::string> plan; ///< Sequence of action names.
-    parser::WorldState final_state;
+    WorldState final_state;
     size_t iterations = 0;
+    float cost = 0;                ///< Sum of the action costs of @c plan.
+    std::vector<PlanImprovement> improvements; ///< Successive plans of an anytime search, @c plan last.
+    StopReason stop_reason = StopReason::Solved; ///< Why the search returned (with or without a plan).
+};
+
+/// *****************************************************************************
+/// Snapshot of a running search, sent to SolverContext::progress.
+/// *****************************************************************************
+struct SearchProgress
+{
+    size_t iterations   = 0; ///< Iterations so far.
+    size_t open         = 0; ///< Nodes waiting for expansion (IDA*: depth of the current path).
+    float  best_f       = 0; ///< f of the last expanded node (GBFS: best h so far, IDA*: bound).
+    size_t memory_bytes = 0; ///< Approximate memory held by the search structures.
+    double seconds      = 0; ///< Time since the start of solve().
+};
+
+/// Receiver of progress snapshots, called on the thread running the search.
+/// The multi-threaded HDA* and portfolio planners send none.
+using ProgressCallback = std::function<void(const SearchProgress&)>;
+
+class LandmarkGraph;
+class PatternDatabase;
+
+/// *****************************************************************************
+/// Per-problem analyses computed on first use and shared by every solve run
+/// on the same SolverContext (see landmarks_of(), pattern_database_of()).
+/// *****************************************************************************
+struct TaskCache
+{
+    std::mutex                             mutex;     ///< Guards the members below.
+    std::shared_ptr<const LandmarkGraph>   landmarks; ///< Landmarks and orderings.
+    std::shared_ptr<const PatternDatabase> patterns;  ///< Abstract goal distances.
 };
 
 /// *****************************************************************************
@@ -48,10 +166,116 @@ struct PlanResult
 /// *****************************************************************************
 struct SolverContext
 {
-    const parser::WorldState&                  initial;
+    const WorldState&                          initial;
     const std::vector<GroundAction>&           actions;
-    const std::vector<parser::Predicate>&      goals;
+    const std::vector<GroundCondition>&        goals;
     const std::vector<GroundDerivedPredicate>& derived; ///< Grounded derived predicates.
+    const AtomTable&                           atoms;   ///< Names of atoms and fluents (debug printing).
+    std::shared_ptr<TaskCache>                 cache = std::make_shared<TaskCache>(); ///< Cached analyses.
+    std::stop_token                            stop{};  ///< Cooperative cancellation (default: never requested).
+    std::optional<std::chrono::steady_clock::time_point> deadline{}; ///< Wall-clock limit of solve() (default: none).
+    ProgressCallback                           progress{}; ///< Periodic snapshots (default: none).
+    size_t                                     progress_period = 1000; ///< Iterations between two snapshots.
+};
+
+/// *****************************************************************************
+/// Sends SearchProgress snapshots to SolverContext::progress every
+/// SolverContext::progress_period iterations of a search loop.
+///
+/// A snapshot stays due until one is sent, so iterations that skip the check
+/// (pruned duplicates) only delay it.
+/// *****************************************************************************
+class ProgressReporter
+{
+public:
+
+    explicit ProgressReporter(const SolverContext& ctx)
+        : m_callback(ctx.progress ? &ctx.progress : nullptr), m_period(std::max<size_t>(ctx.progress_period, 1)),
+          m_next(m_period), m_started(std::chrono::steady_clock::now())
+    {
+    }
+
+    /// True when a snapshot is due after @p iterations.
+    bool due(size_t iterations) const
+    {
+        return m_callback && iterations >= m_next;
+    }
+
+    /// Send @p snapshot, stamped with the time since construction; the next
+    /// one is due at the next multiple of the period.
+    void operator()(SearchProgress snapshot)
+    {
+        m_next = (snapshot.iterations / m_period + 1) * m_period;
+        snapshot.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_started).count();
+        (*m_callback)(snapshot);
+    }
+
+private:
+
+    const ProgressCallback* m_callback;              ///< Receiver (nullptr = none).
+    size_t m_period;                                 ///< Iterations between two snapshots.
+    size_t m_next;                                   ///< Iterations at which the next snapshot is due.
+    std::chrono::steady_clock::time_point m_started; ///< Start of the search.
+};
+
+/// *****************************************************************************
+/// Limits of one solve run: SolverContext::stop, SolverContext::deadline and
+/// an iteration budget, polled once per iteration of a search loop.
+///
+/// The stop token and the iteration count are checked on every call, the
+/// clock only every CLOCK_PERIOD calls, so the check costs an atomic load and
+/// a comparison in the common case.
+/// *****************************************************************************
+class StopCondition
+{
+public:
+
+    static constexpr size_t CLOCK_PERIOD = 32; ///< Calls between two reads of the clock.
+
+    /// @param time_limit  Solver-specific limit from now, combined with the context deadline (0 = none).
+    StopCondition(const SolverContext& ctx, size_t max_iterations, std::chrono::milliseconds time_limit = {})
+        : m_stop(ctx.stop), m_deadline(ctx.deadline), m_max_iterations(max_iterations)
+    {
+        if (time_limit.count() > 0)
+        {
+            const auto limit = std::chrono::steady_clock::now() + time_limit;
+            m_deadline = m_deadline ? std::min(*m_deadline, limit) : limit;
+        }
+    }
+
+    /// True once the search must return after @p iterations; reason() then tells why.
+    bool operator()(size_t iterations)
+    {
+        if (iterations >= m_max_iterations)
+            m_reason = StopReason::IterationLimit;
+        else if (m_stop.stop_requested())
+            m_reason = StopReason::Cancelled;
+        else if (m_deadline && ++m_calls % CLOCK_PERIOD == 0 && std::chrono::steady_clock::now() >= *m_deadline)
+            m_reason = StopReason::Deadline;
+        else
+            return false;
+        return true;
+    }
+
+    /// Cause of the last positive check, or Exhausted if there was none.
+    StopReason reason() const
+    {
+        return m_reason;
+    }
+
+    /// Effective deadline (context deadline and time limit), if any.
+    const std::optional<std::chrono::steady_clock::time_point>& deadline() const
+    {
+        return m_deadline;
+    }
+
+private:
+
+    std::stop_token m_stop;                                          ///< Cancellation token.
+    std::optional<std::chrono::steady_clock::time_point> m_deadline; ///< Earliest deadline.
+    size_t m_max_iterations;                                         ///< Iteration budget.
+    size_t m_calls = 0;                                              ///< Checks so far, for the clock period.
+    StopReason m_reason = StopReason::Exhausted;                     ///< Cause of the stop.
 };
 
 /// *****************************************************************************
@@ -62,7 +286,10 @@ class ISolver
 public:
     virtual ~ISolver() = default;
 
-    /// Run the planner and return a PlanResult.
+    /// Run the planner and return a PlanResult.  Once @c ctx.stop is
+    /// requested or @c ctx.deadline passes, the search returns early, without
+    /// a plan or with the best plan found so far; PlanResult::stop_reason
+    /// tells why it returned.
     virtual PlanResult solve(const SolverContext& ctx) = 0;
 };
 
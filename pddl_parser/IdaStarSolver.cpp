@@ -0,0 +1,193 @@
+#include "IdaStarSolver.hpp"
+#include "AStarSolver.hpp"
+#include "SuccessorGenerator.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Depth-first frame: a node on the current path and the child being explored.
+/// *****************************************************************************
+struct IdaFrame
+{
+    float g = 0;                           ///< Cost of the path to the node.
+    std::vector<std::uint32_t> candidates; ///< Actions left to try, from the successor generator.
+    size_t next = 0;                       ///< Next candidate.
+    std::uint32_t action = 0;              ///< Action leading to the open child.
+    bool child_open = false;               ///< The state currently holds the child of @c action.
+    DerivedEvaluator::UndoLog undo;        ///< Restores the node from its open child.
+};
+
+/// *****************************************************************************
+/// Transposition-table slot.
+/// *****************************************************************************
+struct IdaEntry
+{
+    std::uint64_t hash = 0;      ///< Zobrist hash of the state.
+    float g = 0;                 ///< Lowest g of the state in iteration @c iteration.
+    std::uint32_t iteration = 0; ///< Iteration of the visit (0 = empty slot).
+};
+
+/// *****************************************************************************
+/// ISolver::solve implementation
+/// *****************************************************************************
+PlanResult IdaStarSolver::solve(const SolverContext& ctx)
+{
+    const auto& actions = ctx.actions;
+    const auto& goals = ctx.goals;
+    const auto& cfg = m_config;
+
+    std::unique_ptr<IHeuristic> heuristic = make_heuristic(cfg.heuristic_kind, ctx);
+    const SuccessorGenerator successors(actions);
+    DerivedEvaluator axioms(ctx.derived);
+
+    WorldState ws = ctx.initial;
+    ws.set_hash_bucket(cfg.fluent_bucket_size);
+
+    std::vector<IdaFrame> stack;
+    std::vector<std::uint64_t> path; ///< Hashes of the states on the current path.
+    WorldState ancestor;             ///< Path state rebuilt to confirm a hash hit.
+    std::vector<IdaEntry> table(cfg.transposition_table_size);
+
+    constexpr float UNBOUNDED = std::numeric_limits<float>::infinity();
+    float bound = heuristic->evaluate(ws);
+    float next_bound = UNBOUNDED;
+    std::uint32_t iteration = 0;
+    size_t iterations = 0;
+    StopCondition limits(ctx, cfg.max_iterations);
+    ProgressReporter progress(ctx);
+
+    enum class Visit { Cut, Goal, Expanded };
+
+    // Visit the node held by ws at cost g: cut it, report a goal, or push its frame.
+    auto visit = [&](float g)
+    {
+        ++iterations;
+        if (progress.due(iterations))
+            progress({ iterations, stack.size(), bound,
+                       stack.capacity() * sizeof(IdaFrame) + table.capacity() * sizeof(IdaEntry) });
+        const float h = heuristic->evaluate(ws);
+        if (h == DEAD_END)
+            return Visit::Cut;
+        if (g + h > bound)
+        {
+            next_bound = std::min(next_bound, g + h);
+            return Visit::Cut;
+        }
+        if (ws.is_goal_reached(goals))
+            return Visit::Goal;
+        if (!table.empty())
+        {
+            IdaEntry& entry = table[ws.hash() % table.size()];
+            if (entry.iteration == iteration && entry.hash == ws.hash() && entry.g <= g)
+                return Visit::Cut;
+            entry = { ws.hash(), g, iteration };
+        }
+        stack.emplace_back();
+        stack.back().g = g;
+        successors.generate(ws, stack.back().candidates);
+        return Visit::Expanded;
+    };
+
+    // True if the child just opened in ws repeats a state of the current path.
+    // Hashes are bucketed, so a hit is confirmed on the ancestor rebuilt by
+    // reverting the undo logs of the frames above it.
+    auto on_path = [&]
+    {
+        size_t reverted = stack.size();
+        for (size_t i = stack.size(); i-- > 0;)
+        {
+            if (path[i] != path.back())
+                continue;
+            if (reverted == stack.size())
+                ancestor = ws;
+            while (reverted > i)
+                DerivedEvaluator::revert(stack[--reverted].undo, ancestor);
+            if (ancestor == ws)
+                return true;
+        }
+        return false;
+    };
+
+    auto found = [&]
+    {
+        PlanResult result;
+        result.success = true;
+        result.final_state = ws;
+        result.iterations = iterations;
+        for (const auto& frame : stack)
+            result.plan.push_back(actions[frame.action].name);
+        result.cost = stack.empty() ? 0 : stack.back().g + static_cast<float>(actions[stack.back().action].cost);
+        if (cfg.verbose)
+            std::cerr << "[ida*] Goal reached after " << iterations << " iterations, bound " << bound << "\n";
+        return result;
+    };
+
+    while (bound != DEAD_END && bound != UNBOUNDED)
+    {
+        ++iteration;
+        next_bound = UNBOUNDED;
+        path.assign(1, ws.hash());
+        if (visit(0) == Visit::Goal)
+            return found();
+
+        while (!stack.empty())
+        {
+            if (limits(iterations))
+            {
+                if (cfg.verbose)
+                    std::cerr << "[ida*] Stopped at bound " << bound << " after " << iterations << " iterations ("
+                              << stop_reason_name(limits.reason()) << ")\n";
+                PlanResult result;
+                result.final_state = ctx.initial;
+                result.iterations = iterations;
+                result.stop_reason = limits.reason();
+                return result;
+            }
+
+            IdaFrame& top = stack.back();
+            if (top.child_open)
+            {
+                DerivedEvaluator::revert(top.undo, ws);
+                path.pop_back();
+                top.child_open = false;
+            }
+            if (top.next == top.candidates.size())
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            const std::uint32_t a = top.candidates[top.next++];
+            if (!AStarSolver::is_applicable(actions[a], ws))
+                continue;
+            axioms.apply(actions[a], ws, &top.undo);
+            top.action = a;
+            top.child_open = true;
+            path.push_back(ws.hash());
+            if (on_path())
+                continue; // Cycle on the current path.
+
+            // visit() may grow the stack, so top is not used past this point.
+            if (visit(top.g + static_cast<float>(actions[a].cost)) == Visit::Goal)
+                return found();
+        }
+
+        if (cfg.verbose)
+            std::cerr << "[ida*] Bound " << bound << " exhausted after " << iterations << " iterations\n";
+        bound = next_bound;
+    }
+
+    if (cfg.verbose)
+        std::cerr << "[ida*] No plan found after " << iterations << " iterations\n";
+    PlanResult result;
+    result.final_state = ctx.initial;
+    result.iterations = iterations;
+    result.stop_reason = StopReason::Exhausted;
+    return result;
+}
+
+} // namespace pddl::solver
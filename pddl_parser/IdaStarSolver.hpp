@@ -0,0 +1,62 @@
+/// @file IdaStarSolver.hpp
+/// Memory-bounded iterative-deepening A* planner.
+#pragma once
+
+#include "Heuristic.hpp"
+#include "ISolver.hpp"
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Configuration for the IDA* planner.
+/// *****************************************************************************
+struct IdaConfig
+{
+    size_t max_iterations = 10'000'000; ///< Maximum number of visited nodes over all iterations.
+    int fluent_bucket_size = 10;        ///< Granularity for state hashing (0 = exact).
+    bool verbose = false;               ///< Print debug info during search.
+
+    /// Built-in heuristic (admissible for optimal plans).
+    HeuristicKind heuristic_kind = HeuristicKind::GoalCount;
+
+    /// Entries of the transposition table (0 = none).  The table costs
+    /// 16 bytes per entry whatever the search depth; see IdaStarSolver for
+    /// its effect on optimality.
+    size_t transposition_table_size = 0;
+};
+
+/// *****************************************************************************
+/// Iterative-deepening A* (Korf).
+///
+/// Runs depth-first searches bounded by f = g + h, raising the bound to the
+/// smallest f that exceeded it until a goal is reached; with an admissible
+/// heuristic the first plan found is optimal.  A single WorldState is updated
+/// in place with DerivedEvaluator::apply() and restored with revert() when
+/// backtracking, so memory is O(depth x branching) instead of one state per
+/// generated node.
+///
+/// States repeated on the current path are cut: their Zobrist hashes (with
+/// the configured fluent buckets) are compared first, and a hit is confirmed
+/// on the full state.  The optional transposition table remembers, per hash
+/// slot, the lowest g a state was visited with in the current iteration and
+/// cuts later visits that are not cheaper.  It only keeps hashes, so states
+/// sharing a hash (a collision, or fluents in the same bucket) are taken for
+/// one another: with the table, plans are optimal only modulo such merges;
+/// use a fluent bucket size of 0 to limit them to true collisions.
+/// *****************************************************************************
+class IdaStarSolver: public ISolver
+{
+public:
+
+    explicit IdaStarSolver(IdaConfig cfg = {}) : m_config(std::move(cfg)) {}
+
+    /// @copydoc ISolver::solve
+    PlanResult solve(const SolverContext& ctx) override;
+
+private:
+
+    IdaConfig m_config;
+};
+
+} // namespace pddl::solver
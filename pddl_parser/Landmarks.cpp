@@ -0,0 +1,324 @@
+#include "Landmarks.hpp"
+#include <algorithm>
+#include <deque>
+#include <iterator>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Relaxed operator used for label propagation.  Propositions are the atoms,
+/// then the numeric conditions (see NumericConditions) from @c atom_count on.
+/// *****************************************************************************
+struct LabelOperator
+{
+    std::vector<std::uint32_t> pre; ///< Proposition preconditions.
+    std::vector<std::uint32_t> add; ///< Propositions added or moved towards.
+    float cost = 0;                 ///< Cost of the action (0 for derived predicates).
+};
+
+/// *****************************************************************************
+/// Propositions of the label propagation and their operators: one per action
+/// for its unconditional effects, one per conditional effect (with its guard),
+/// one per derived predicate.
+/// *****************************************************************************
+struct LabelTask
+{
+    explicit LabelTask(const SolverContext& ctx);
+
+    /// Proposition of @p c, or UINT32_MAX for a negative fact (relaxed away).
+    std::uint32_t proposition(const GroundCondition& c) const;
+
+    /// Propositions of @p conds, sorted and deduplicated.
+    std::vector<std::uint32_t> propositions(const std::vector<GroundCondition>& conds) const;
+
+    /// Condition testing proposition @p p.
+    NumericConditions::Condition condition(std::uint32_t p) const;
+
+    NumericConditions numeric;      ///< Numeric propositions.
+    size_t atom_count = 0;          ///< Atom propositions, derived heads included.
+    std::vector<LabelOperator> ops; ///< Relaxed operators.
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+LabelTask::LabelTask(const SolverContext& ctx) : numeric(ctx), atom_count(ctx.atoms.atom_count())
+{
+    for (const auto& gdp : ctx.derived)
+        atom_count = std::max<size_t>(atom_count, gdp.head + 1);
+
+    std::vector<NumericConditions::Move> moves;
+    auto add_effect = [&](LabelOperator& op, const GroundEffect& e)
+    {
+        if (e.kind == GroundEffect::Kind::Add)
+            op.add.push_back(e.atom);
+        moves.clear();
+        numeric.moves(e, moves);
+        for (const auto& m : moves)
+            op.add.push_back(static_cast<std::uint32_t>(atom_count + m.index));
+    };
+    auto finish = [&](LabelOperator& op)
+    {
+        std::sort(op.add.begin(), op.add.end());
+        op.add.erase(std::unique(op.add.begin(), op.add.end()), op.add.end());
+        if (!op.add.empty())
+            ops.push_back(std::move(op));
+    };
+
+    for (const auto& action : ctx.actions)
+    {
+        LabelOperator base;
+        base.pre = propositions(action.preconditions);
+        base.cost = static_cast<float>(action.cost);
+        for (const auto& e : action.effects)
+        {
+            if (!e.when)
+            {
+                add_effect(base, e);
+                continue;
+            }
+            LabelOperator op{ base.pre, {}, base.cost };
+            if (auto p = proposition(*e.when); p != UINT32_MAX && !std::binary_search(op.pre.begin(), op.pre.end(), p))
+                op.pre.insert(std::lower_bound(op.pre.begin(), op.pre.end(), p), p);
+            add_effect(op, e);
+            finish(op);
+        }
+        finish(base);
+    }
+    for (const auto& gdp : ctx.derived)
+        ops.push_back({ propositions(gdp.conditions), { gdp.head }, 0 });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::uint32_t LabelTask::proposition(const GroundCondition& c) const
+{
+    switch (c.kind)
+    {
+        case GroundCondition::Kind::Fact:
+            return c.atom;
+        case GroundCondition::Kind::NotFact:
+            return UINT32_MAX;
+        case GroundCondition::Kind::Compare:
+            break;
+    }
+    return static_cast<std::uint32_t>(atom_count + numeric.index_of(c));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::vector<std::uint32_t> LabelTask::propositions(const std::vector<GroundCondition>& conds) const
+{
+    std::vector<std::uint32_t> props;
+    for (const auto& c : conds)
+        if (auto p = proposition(c); p != UINT32_MAX)
+            props.push_back(p);
+    std::sort(props.begin(), props.end());
+    props.erase(std::unique(props.begin(), props.end()), props.end());
+    return props;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+NumericConditions::Condition LabelTask::condition(std::uint32_t p) const
+{
+    if (p >= atom_count)
+        return numeric[p - atom_count];
+    NumericConditions::Condition c;
+    c.cond.atom = p;
+    return c;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+LandmarkGraph::LandmarkGraph(const SolverContext& ctx)
+{
+    const LabelTask task(ctx);
+    const std::vector<LabelOperator>& ops = task.ops;
+    const size_t prop_count = task.atom_count + task.numeric.size();
+
+    std::vector<std::vector<std::uint32_t>> readers(prop_count);
+    for (std::uint32_t o = 0; o < ops.size(); ++o)
+        for (auto p : ops[o].pre)
+            readers[p].push_back(o);
+
+    // Labels: unreached propositions have no label yet (the "all propositions" top element).
+    std::vector<std::vector<std::uint32_t>> label(prop_count);
+    std::vector<char> reached(prop_count, 0);
+    std::vector<std::uint32_t> missing(ops.size());
+    std::deque<std::uint32_t> work;
+    std::vector<char> queued(ops.size(), 0);
+    auto schedule = [&](std::uint32_t o)
+    {
+        if (missing[o] == 0 && !queued[o])
+        {
+            queued[o] = 1;
+            work.push_back(o);
+        }
+    };
+    auto reach_initially = [&](std::uint32_t p)
+    {
+        reached[p] = 1;
+        label[p] = { p };
+        for (auto o : readers[p])
+            --missing[o];
+    };
+
+    for (std::uint32_t o = 0; o < ops.size(); ++o)
+        missing[o] = static_cast<std::uint32_t>(ops[o].pre.size());
+    for (auto p : ctx.initial.get_facts())
+        if (p < task.atom_count)
+            reach_initially(p);
+    for (size_t j = 0; j < task.numeric.size(); ++j)
+        if (ctx.initial.evaluates(task.numeric[j].cond))
+            reach_initially(static_cast<std::uint32_t>(task.atom_count + j));
+    for (std::uint32_t o = 0; o < ops.size(); ++o)
+        schedule(o);
+
+    std::vector<std::uint32_t> through, merged;
+    while (!work.empty())
+    {
+        const std::uint32_t o = work.front();
+        work.pop_front();
+        queued[o] = 0;
+
+        // Propositions needed before any proposition added by o.
+        through.clear();
+        for (auto q : ops[o].pre)
+        {
+            merged.clear();
+            std::set_union(through.begin(), through.end(), label[q].begin(), label[q].end(),
+                           std::back_inserter(merged));
+            through.swap(merged);
+        }
+
+        for (auto p : ops[o].add)
+        {
+            merged = through;
+            merged.insert(std::lower_bound(merged.begin(), merged.end(), p), p);
+            merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+            if (reached[p])
+            {
+                std::vector<std::uint32_t> common;
+                std::set_intersection(label[p].begin(), label[p].end(), merged.begin(), merged.end(),
+                                      std::back_inserter(common));
+                if (common.size() == label[p].size())
+                    continue;
+                label[p] = std::move(common);
+            }
+            else
+            {
+                reached[p] = 1;
+                label[p] = merged;
+                for (auto r : readers[p])
+                    --missing[r];
+            }
+            for (auto r : readers[p])
+                schedule(r);
+        }
+    }
+
+    // Landmarks: labels of the goals.
+    std::vector<std::uint32_t> goals = task.propositions(ctx.goals), all;
+    for (auto g : goals)
+    {
+        if (!reached[g])
+        {
+            m_solvable = false;
+            return;
+        }
+        all.insert(all.end(), label[g].begin(), label[g].end());
+    }
+    std::sort(all.begin(), all.end());
+    all.erase(std::unique(all.begin(), all.end()), all.end());
+
+    std::vector<std::uint32_t> index(prop_count, UINT32_MAX);
+    std::vector<std::uint32_t> props;
+    for (auto p : all)
+    {
+        const bool goal = std::binary_search(goals.begin(), goals.end(), p);
+        NumericConditions::Condition c = task.condition(p);
+        if (!goal && ctx.initial.evaluates(c.cond))
+            continue;
+        index[p] = static_cast<std::uint32_t>(m_landmarks.size());
+        m_landmarks.push_back(std::move(c));
+        m_goal.push_back(goal ? 1 : 0);
+        props.push_back(p);
+    }
+
+    m_successors.resize(m_landmarks.size());
+    for (std::uint32_t i = 0; i < m_landmarks.size(); ++i)
+        for (auto q : label[props[i]])
+            if (q != props[i] && index[q] != UINT32_MAX)
+                m_successors[index[q]].push_back(i);
+
+    m_min_cost.assign(m_landmarks.size(), DEAD_END);
+    for (const auto& op : ops)
+        for (auto p : op.add)
+            if (index[p] != UINT32_MAX)
+                m_min_cost[index[p]] = std::min(m_min_cost[index[p]], op.cost);
+
+    m_unit_cost.assign(m_landmarks.size(), DEAD_END);
+    std::vector<NumericConditions::Move> moves;
+    for (const auto& action : ctx.actions)
+    {
+        for (const auto& e : action.effects)
+        {
+            moves.clear();
+            task.numeric.moves(e, moves);
+            for (const auto& [j, step] : moves)
+            {
+                const std::uint32_t i = index[task.atom_count + j];
+                if (i != UINT32_MAX)
+                    m_unit_cost[i] = std::min(m_unit_cost[i], step > 0 ? static_cast<float>(action.cost / step) : 0.0f);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float LandmarkGraph::cost(std::uint32_t i, const WorldState& ws) const
+{
+    const NumericConditions::Condition& lm = m_landmarks[i];
+    if (!lm.bounded)
+        return m_min_cost[i];
+    const double gap = lm.lower ? lm.threshold - ws.get_fluent(lm.fluent) : ws.get_fluent(lm.fluent) - lm.threshold;
+    if (gap <= 0)
+        return m_min_cost[i]; // Strict bound met with equality.
+    return std::max(m_min_cost[i], static_cast<float>(gap) * m_unit_cost[i]);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<const LandmarkGraph> landmarks_of(const SolverContext& ctx)
+{
+    if (!ctx.cache)
+        return std::make_shared<const LandmarkGraph>(ctx);
+    std::lock_guard lock(ctx.cache->mutex);
+    if (!ctx.cache->landmarks)
+        ctx.cache->landmarks = std::make_shared<const LandmarkGraph>(ctx);
+    return ctx.cache->landmarks;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+LandmarkCountHeuristic::LandmarkCountHeuristic(const SolverContext& ctx) : m_graph(landmarks_of(ctx))
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float LandmarkCountHeuristic::evaluate(const WorldState& ws)
+{
+    const LandmarkGraph& g = *m_graph;
+    if (!g.solvable())
+        return DEAD_END;
+
+    float h = 0;
+    const auto& landmarks = g.landmarks();
+    for (std::uint32_t i = 0; i < landmarks.size(); ++i)
+    {
+        if (ws.evaluates(landmarks[i].cond))
+            continue;
+        const auto& next = g.successors(i);
+        if (!g.is_goal(i) &&
+            std::any_of(next.begin(), next.end(), [&](std::uint32_t j) { return ws.evaluates(landmarks[j].cond); }))
+            continue;
+        h += g.cost(i, ws);
+    }
+    return h;
+}
+
+} // namespace pddl::solver
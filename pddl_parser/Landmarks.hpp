@@ -0,0 +1,107 @@
+/// @file Landmarks.hpp
+/// Landmarks, their orderings, and the heuristics built on them.
+#pragma once
+
+#include "Heuristic.hpp"
+#include "NumericConditions.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Landmarks of the task: atoms and numeric conditions true at some point of
+/// every plan.
+///
+/// Extracted with the label propagation of Zhu & Givan over the delete
+/// relaxation: the label of a proposition is the set of propositions any
+/// relaxed plan reaching it must reach first,
+///     LM(p) = {p} ∪ ⋂_{a adds p} ⋃_{q ∈ pre(a)} LM(q),
+/// computed as a fixpoint from the initial state.  A numeric condition is a
+/// proposition added by every action moving one of its fluents towards it
+/// (see NumericConditions).  The landmarks are the labels of the goals, and
+/// every @c q ∈ LM(p) gives the natural ordering @c q before @c p.  Negative
+/// conditions are relaxed away, which only loses landmarks, never makes a
+/// false one.
+///
+/// Landmarks true in the initial state are dropped unless they are goals.
+/// *****************************************************************************
+class LandmarkGraph
+{
+public:
+
+    explicit LandmarkGraph(const SolverContext& ctx);
+
+    /// Landmarks: Fact or Compare conditions, with their bound form.
+    const std::vector<NumericConditions::Condition>& landmarks() const
+    {
+        return m_landmarks;
+    }
+
+    /// Indices (in landmarks()) of the landmarks ordered after landmark @p i.
+    const std::vector<std::uint32_t>& successors(std::uint32_t i) const
+    {
+        return m_successors[i];
+    }
+
+    /// True if landmark @p i is a goal (needed again even once reached).
+    bool is_goal(std::uint32_t i) const
+    {
+        return m_goal[i] != 0;
+    }
+
+    /// Cost of the cheapest action adding (or moving towards) landmark @p i.
+    float min_cost(std::uint32_t i) const
+    {
+        return m_min_cost[i];
+    }
+
+    /// Cost of reaching landmark @p i from @p ws: its cheapest achiever, or
+    /// for a bound the gap in @p ws times the lowest cost per unit of progress
+    /// if that is more.
+    float cost(std::uint32_t i, const WorldState& ws) const;
+
+    /// False if some goal is unreachable even in the delete relaxation.
+    bool solvable() const
+    {
+        return m_solvable;
+    }
+
+private:
+
+    std::vector<NumericConditions::Condition> m_landmarks; ///< Landmark conditions.
+    std::vector<std::vector<std::uint32_t>> m_successors;  ///< Orderings, by landmark index.
+    std::vector<char> m_goal;                              ///< Landmark is a goal.
+    std::vector<float> m_min_cost;                         ///< Cheapest achiever cost per landmark.
+    std::vector<float> m_unit_cost;                        ///< Lowest cost per unit of progress per bound.
+    bool m_solvable = true;                                ///< Goals relaxed-reachable.
+};
+
+/// Landmark graph of @p ctx, extracted on the first call and cached in
+/// @c ctx.cache for later solves.  Thread-safe.
+std::shared_ptr<const LandmarkGraph> landmarks_of(const SolverContext& ctx);
+
+/// *****************************************************************************
+/// Landmark-count heuristic: cost of the landmarks still to reach.
+///
+/// State-based approximation of the accepted landmarks of a path: a landmark
+/// counts as reached when it holds in the state or when a landmark ordered
+/// after it does; goal landmarks only when they hold.  Each unreached
+/// landmark costs LandmarkGraph::cost().  Not admissible.
+/// *****************************************************************************
+class LandmarkCountHeuristic: public IHeuristic
+{
+public:
+
+    explicit LandmarkCountHeuristic(const SolverContext& ctx);
+
+    /// @copydoc IHeuristic::evaluate
+    float evaluate(const WorldState& ws) override;
+
+private:
+
+    std::shared_ptr<const LandmarkGraph> m_graph;
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,211 @@
+#include "LmCutHeuristic.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace pddl::solver
+{
+
+/// Marker of an operator whose preconditions are not all reached.
+static constexpr std::uint32_t UNREACHED = UINT32_MAX;
+
+//---------------------------------------------------------------------------------------------------------------------
+LmCutHeuristic::LmCutHeuristic(const SolverContext& ctx) : m_numeric(ctx)
+{
+    std::uint32_t atom_count = static_cast<std::uint32_t>(ctx.atoms.atom_count());
+    for (const auto& gdp : ctx.derived)
+        atom_count = std::max(atom_count, gdp.head + 1);
+    m_atom_count = atom_count;
+    m_init = atom_count + static_cast<std::uint32_t>(m_numeric.size());
+    m_goal = m_init + 1;
+
+    // Negative facts are relaxed away.
+    auto facts_of = [&](const std::vector<GroundCondition>& conds)
+    {
+        std::vector<std::uint32_t> facts;
+        for (const auto& c : conds)
+            if (c.kind == GroundCondition::Kind::Fact)
+                facts.push_back(c.atom);
+            else if (c.kind == GroundCondition::Kind::Compare)
+                facts.push_back(m_atom_count + m_numeric.index_of(c));
+        std::sort(facts.begin(), facts.end());
+        facts.erase(std::unique(facts.begin(), facts.end()), facts.end());
+        if (facts.empty())
+            facts.push_back(m_init);
+        return facts;
+    };
+
+    std::vector<NumericConditions::Move> moves;
+    for (const auto& action : ctx.actions)
+    {
+        Operator op;
+        op.pre = facts_of(action.preconditions);
+        op.cost = static_cast<float>(action.cost);
+        for (const auto& e : action.effects)
+        {
+            if (e.kind == GroundEffect::Kind::Add)
+                op.add.push_back(e.atom);
+            moves.clear();
+            m_numeric.moves(e, moves);
+            for (const auto& m : moves)
+                op.add.push_back(m_atom_count + m.index);
+        }
+        std::sort(op.add.begin(), op.add.end());
+        op.add.erase(std::unique(op.add.begin(), op.add.end()), op.add.end());
+        if (!op.add.empty())
+            m_ops.push_back(std::move(op));
+    }
+    for (const auto& gdp : ctx.derived)
+        m_ops.push_back({ facts_of(gdp.conditions), { gdp.head }, 0.0f });
+    m_ops.push_back({ facts_of(ctx.goals), { m_goal }, 0.0f });
+
+    m_readers.resize(m_goal + 1);
+    m_adders.resize(m_goal + 1);
+    for (std::uint32_t o = 0; o < m_ops.size(); ++o)
+    {
+        for (auto p : m_ops[o].pre)
+            m_readers[p].push_back(o);
+        for (auto e : m_ops[o].add)
+            m_adders[e].push_back(o);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void LmCutHeuristic::collect_state(const WorldState& ws)
+{
+    m_state.assign(1, m_init);
+    for (auto p : ws.get_facts())
+        if (p < m_atom_count)
+            m_state.push_back(p);
+    for (std::uint32_t j = 0; j < m_numeric.size(); ++j)
+        if (ws.evaluates(m_numeric[j].cond))
+            m_state.push_back(m_atom_count + j);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void LmCutHeuristic::compute_hmax()
+{
+    m_hmax.assign(m_goal + 1, DEAD_END);
+    m_pcf.assign(m_ops.size(), UNREACHED);
+    m_missing.resize(m_ops.size());
+    for (size_t o = 0; o < m_ops.size(); ++o)
+        m_missing[o] = static_cast<std::uint32_t>(m_ops[o].pre.size());
+    m_queue.clear();
+
+    auto reach = [&](std::uint32_t f, float cost)
+    {
+        if (cost >= m_hmax[f])
+            return;
+        m_hmax[f] = cost;
+        m_queue.emplace_back(cost, f);
+        std::push_heap(m_queue.begin(), m_queue.end(), std::greater<>());
+    };
+    for (auto p : m_state)
+        reach(p, 0);
+
+    while (!m_queue.empty())
+    {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<>());
+        const auto [cost, f] = m_queue.back();
+        m_queue.pop_back();
+        if (cost > m_hmax[f])
+            continue;
+
+        // Facts are popped in increasing h_max order, so the last
+        // precondition reached is the one with the largest h_max.
+        for (auto o : m_readers[f])
+        {
+            if (--m_missing[o] != 0)
+                continue;
+            m_pcf[o] = f;
+            for (auto e : m_ops[o].add)
+                reach(e, cost + m_cost[o]);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float LmCutHeuristic::evaluate(const WorldState& ws)
+{
+    m_cost.resize(m_ops.size());
+    for (size_t o = 0; o < m_ops.size(); ++o)
+        m_cost[o] = m_ops[o].cost;
+
+    collect_state(ws);
+
+    float h = 0;
+    for (;;)
+    {
+        compute_hmax();
+        if (m_hmax[m_goal] == DEAD_END)
+            return DEAD_END;
+        if (m_hmax[m_goal] == 0)
+            return h;
+
+        // Goal zone: facts reaching the goal through zero-cost justification edges.
+        m_zone.assign(m_goal + 1, 0);
+        m_zone[m_goal] = 1;
+        m_stack.assign(1, m_goal);
+        while (!m_stack.empty())
+        {
+            const std::uint32_t f = m_stack.back();
+            m_stack.pop_back();
+            for (auto o : m_adders[f])
+            {
+                const std::uint32_t p = m_pcf[o];
+                if (p != UNREACHED && m_cost[o] == 0 && !m_zone[p])
+                {
+                    m_zone[p] = 1;
+                    m_stack.push_back(p);
+                }
+            }
+        }
+
+        // Facts justified from the state without entering the goal zone; the
+        // operators leaving them for the goal zone form the cut.
+        m_cut.clear();
+        m_stack.clear();
+        for (auto p : m_state)
+        {
+            if (!m_zone[p])
+            {
+                m_zone[p] = 2;
+                m_stack.push_back(p);
+            }
+        }
+        while (!m_stack.empty())
+        {
+            const std::uint32_t f = m_stack.back();
+            m_stack.pop_back();
+            for (auto o : m_readers[f])
+            {
+                if (m_pcf[o] != f)
+                    continue;
+                bool in_cut = false;
+                for (auto e : m_ops[o].add)
+                {
+                    if (m_zone[e] == 1)
+                        in_cut = true;
+                    else if (!m_zone[e])
+                    {
+                        m_zone[e] = 2;
+                        m_stack.push_back(e);
+                    }
+                }
+                if (in_cut)
+                    m_cut.push_back(o);
+            }
+        }
+
+        if (m_cut.empty())
+            return h; // Cannot happen when h_max(goal) > 0; guards against looping.
+
+        float cut_cost = DEAD_END;
+        for (auto o : m_cut)
+            cut_cost = std::min(cut_cost, m_cost[o]);
+        h += cut_cost;
+        for (auto o : m_cut)
+            m_cost[o] -= cut_cost;
+    }
+}
+
+} // namespace pddl::solver
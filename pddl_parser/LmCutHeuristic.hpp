@@ -0,0 +1,72 @@
+/// @file LmCutHeuristic.hpp
+/// Admissible LM-cut heuristic over the propositional delete relaxation.
+#pragma once
+
+#include "Heuristic.hpp"
+#include "NumericConditions.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// LM-cut (Helmert & Domshlak): repeatedly computes h_max, cuts the
+/// justification graph between the state and the goal zone, and charges the
+/// cheapest operator of the cut, which is a disjunctive action landmark.
+///
+/// The relaxation keeps fact preconditions and adds only.  Each numeric
+/// condition is a fact added by the actions moving one of its fluents towards
+/// it (see NumericConditions), as if one application always sufficed.
+/// Negative conditions are dropped and conditional effects are merged into
+/// their action, so the result stays admissible.  Derived predicates are
+/// zero-cost operators.
+/// *****************************************************************************
+class LmCutHeuristic: public IHeuristic
+{
+public:
+
+    explicit LmCutHeuristic(const SolverContext& ctx);
+
+    /// @copydoc IHeuristic::evaluate
+    float evaluate(const WorldState& ws) override;
+
+private:
+
+    struct Operator
+    {
+        std::vector<std::uint32_t> pre; ///< Fact preconditions (never empty).
+        std::vector<std::uint32_t> add; ///< Added facts.
+        float cost = 0;                 ///< Original cost.
+    };
+
+    /// Fill @c m_state with the facts true in @p ws, including @c m_init.
+    void collect_state(const WorldState& ws);
+
+    /// Compute @c m_hmax and the precondition choice of every operator under @c m_cost.
+    void compute_hmax();
+
+private:
+
+    NumericConditions m_numeric;                          ///< Numeric facts (from @c m_atom_count on).
+    std::uint32_t m_atom_count = 0;                       ///< Atom facts, derived heads included.
+    std::uint32_t m_init = 0;                             ///< Artificial fact true in every state.
+    std::uint32_t m_goal = 0;                             ///< Artificial fact reached by the goal operator.
+    std::vector<Operator> m_ops;                          ///< Relaxed operators (goal operator last).
+    std::vector<std::vector<std::uint32_t>> m_readers;    ///< Operators with each fact as precondition.
+    std::vector<std::vector<std::uint32_t>> m_adders;     ///< Operators adding each fact.
+
+    // Per-evaluation state.
+    std::vector<std::uint32_t> m_state;                   ///< Facts true in the evaluated state.
+    std::vector<float> m_cost;                            ///< Remaining cost of each operator.
+    std::vector<float> m_hmax;                            ///< h_max of each fact.
+    std::vector<std::uint32_t> m_pcf;                     ///< Precondition choice of each operator.
+    std::vector<std::uint32_t> m_missing;                 ///< Unreached preconditions per operator.
+    std::vector<std::pair<float, std::uint32_t>> m_queue; ///< Min-heap of (h_max, fact).
+    std::vector<char> m_zone;                             ///< 1: goal zone, 2: before the cut.
+    std::vector<std::uint32_t> m_stack;                   ///< Facts left to explore.
+    std::vector<std::uint32_t> m_cut;                     ///< Operators of the current cut.
+};
+
+} // namespace pddl::solver
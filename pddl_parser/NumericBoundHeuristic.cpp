@@ -0,0 +1,139 @@
+#include "NumericBoundHeuristic.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+NumericBoundHeuristic::NumericBoundHeuristic(const SolverContext& ctx)
+{
+    std::vector<char> derived_head;
+    for (const auto& gdp : ctx.derived)
+    {
+        if (gdp.head >= derived_head.size())
+            derived_head.resize(gdp.head + 1, 0);
+        derived_head[gdp.head] = 1;
+    }
+
+    for (const auto& goal : ctx.goals)
+    {
+        GoalBound g;
+        g.cond = goal;
+        if (goal.kind == GroundCondition::Kind::Fact)
+        {
+            // Derived atoms have no adding action: no bound.
+            if (goal.atom < derived_head.size() && derived_head[goal.atom])
+                continue;
+            for (std::uint32_t a = 0; a < ctx.actions.size(); ++a)
+            {
+                const auto& effects = ctx.actions[a].effects;
+                if (std::any_of(effects.begin(), effects.end(), [&](const GroundEffect& e)
+                                { return e.kind == GroundEffect::Kind::Add && e.atom == goal.atom; }))
+                {
+                    g.achievers.push_back(a);
+                    g.one_shot = std::min(g.one_shot, static_cast<float>(ctx.actions[a].cost));
+                }
+            }
+        }
+        else if (as_bound(goal, g.fluent, g.lower, g.threshold))
+        {
+            g.numeric = true;
+            for (std::uint32_t a = 0; a < ctx.actions.size(); ++a)
+            {
+                const GroundAction& action = ctx.actions[a];
+                double progress = 0;
+                bool one_shot = false;
+                for (const auto& e : action.effects)
+                {
+                    if (e.kind != GroundEffect::Kind::Numeric || e.fluent != g.fluent)
+                        continue;
+                    if (e.value.is_fluent)
+                        one_shot = true; // Unknown amount.
+                    else if (e.op == parser::NumericOp::Assign)
+                        one_shot |= g.lower ? e.value.value >= g.threshold : e.value.value <= g.threshold;
+                    else
+                    {
+                        const double delta = (e.op == parser::NumericOp::Decrease) ? -e.value.value : e.value.value;
+                        progress += std::max(0.0, g.lower ? delta : -delta);
+                    }
+                }
+                if (progress <= 0 && !one_shot)
+                    continue;
+
+                g.achievers.push_back(a);
+                if (one_shot)
+                    g.one_shot = std::min(g.one_shot, static_cast<float>(action.cost));
+                if (progress > 0)
+                    g.best_rate = std::max(g.best_rate, action.cost > 0 ? progress / action.cost
+                                                                        : std::numeric_limits<double>::infinity());
+            }
+        }
+        else
+        {
+            continue; // Negative and non-bound goals contribute nothing.
+        }
+        m_goals.push_back(std::move(g));
+    }
+
+    const size_t n = m_goals.size();
+    m_disjoint.assign(n, std::vector<char>(n, 1));
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = i + 1; j < n; ++j)
+        {
+            const auto& x = m_goals[i].achievers;
+            const auto& y = m_goals[j].achievers;
+            auto ix = x.begin();
+            auto iy = y.begin();
+            while (ix != x.end() && iy != y.end() && *ix != *iy)
+                (*ix < *iy) ? ++ix : ++iy;
+            m_disjoint[i][j] = m_disjoint[j][i] = (ix == x.end() || iy == y.end());
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float NumericBoundHeuristic::bound(const GoalBound& g, const WorldState& ws) const
+{
+    if (ws.evaluates(g.cond))
+        return 0;
+    if (!g.numeric)
+        return g.one_shot;
+
+    const double value = ws.get_fluent(g.fluent);
+    const double gap = std::max(0.0, g.lower ? g.threshold - value : value - g.threshold);
+    const float repeated = (g.best_rate > 0) ? static_cast<float>(gap / g.best_rate) : DEAD_END;
+    return std::min(g.one_shot, repeated);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float NumericBoundHeuristic::evaluate(const WorldState& ws)
+{
+    m_cost.clear();
+    for (std::uint32_t i = 0; i < m_goals.size(); ++i)
+    {
+        const float c = bound(m_goals[i], ws);
+        if (c == DEAD_END)
+            return DEAD_END;
+        if (c > 0)
+            m_cost.emplace_back(c, i);
+    }
+
+    // Greedily sum the largest bounds of goals with disjoint achievers; the
+    // first one picked is the maximum.
+    std::sort(m_cost.begin(), m_cost.end(), [](const auto& x, const auto& y) { return x.first > y.first; });
+    m_picked.clear();
+    float h = 0;
+    for (const auto& [c, i] : m_cost)
+    {
+        if (std::all_of(m_picked.begin(), m_picked.end(), [&](std::uint32_t j) { return m_disjoint[i][j]; }))
+        {
+            m_picked.push_back(i);
+            h += c;
+        }
+    }
+    return h;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,63 @@
+/// @file NumericBoundHeuristic.hpp
+/// Admissible heuristic derived from the rates at which actions move fluents.
+#pragma once
+
+#include "Heuristic.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Admissible bound built automatically from the action effects.
+///
+/// For a numeric goal such as @c (>= (money alice) 1000000) with gap @c g in
+/// the evaluated state, every plan spends at least @c g / r on the actions
+/// moving the fluent, where @c r is the best progress per unit of cost over
+/// all ground actions (conditional effects counted optimistically).  An action
+/// assigning a satisfying value (or an amount unknown at grounding time) caps
+/// the bound at its cost.  An unsatisfied fact goal costs at least the
+/// cheapest action adding it.
+///
+/// Goals whose sets of achieving actions are pairwise disjoint cannot share
+/// an action, so their bounds are summed; the others only contribute through
+/// the maximum.  This is the generic form of the hand-written
+/// "remaining money / best salary, remaining health / sleep gain" estimate.
+/// *****************************************************************************
+class NumericBoundHeuristic: public IHeuristic
+{
+public:
+
+    explicit NumericBoundHeuristic(const SolverContext& ctx);
+
+    /// @copydoc IHeuristic::evaluate
+    float evaluate(const WorldState& ws) override;
+
+private:
+
+    /// Bound of one goal condition.
+    struct GoalBound
+    {
+        GroundCondition cond;                 ///< The goal.
+        bool numeric = false;                 ///< Numeric bound (else fact goal).
+        FluentId fluent = 0;                  ///< Bounded fluent.
+        bool lower = true;                    ///< Lower bound (@c >=) or upper bound (@c <=).
+        double threshold = 0;                 ///< Bound value.
+        double best_rate = 0;                 ///< Best progress per unit of cost (may be infinite).
+        float one_shot = DEAD_END;            ///< Cheapest action reaching the bound at once.
+        std::vector<std::uint32_t> achievers; ///< Actions contributing to the goal (sorted).
+    };
+
+    /// Lower bound on the cost of reaching goal @p g from @p ws.
+    float bound(const GoalBound& g, const WorldState& ws) const;
+
+private:
+
+    std::vector<GoalBound> m_goals;                      ///< Bounded goals.
+    std::vector<std::vector<char>> m_disjoint;           ///< Achiever sets of goals i and j are disjoint.
+    std::vector<std::pair<float, std::uint32_t>> m_cost; ///< Scratch: (bound, goal) of the evaluated state.
+    std::vector<std::uint32_t> m_picked;                 ///< Scratch: goals summed.
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,89 @@
+#include "NumericConditions.hpp"
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+NumericConditions::Key NumericConditions::key_of(const GroundCondition& c)
+{
+    return { c.op, c.lhs.is_fluent, c.lhs.fluent, c.lhs.value, c.rhs.is_fluent, c.rhs.fluent, c.rhs.value };
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+NumericConditions::NumericConditions(const SolverContext& ctx)
+{
+    for (const auto& action : ctx.actions)
+    {
+        for (const auto& c : action.preconditions)
+            collect(c);
+        for (const auto& e : action.effects)
+            if (e.when)
+                collect(*e.when);
+    }
+    for (const auto& gdp : ctx.derived)
+        for (const auto& c : gdp.conditions)
+            collect(c);
+    for (const auto& g : ctx.goals)
+        collect(g);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void NumericConditions::collect(const GroundCondition& c)
+{
+    if (c.kind != GroundCondition::Kind::Compare)
+        return;
+    auto [it, inserted] = m_ids.try_emplace(key_of(c), static_cast<std::uint32_t>(m_conditions.size()));
+    if (!inserted)
+        return;
+    Condition nc;
+    nc.cond = c;
+    nc.bounded = as_bound(c, nc.fluent, nc.lower, nc.threshold);
+    m_conditions.push_back(nc);
+
+    for (const NumericOperand* o : { &c.lhs, &c.rhs })
+    {
+        if (!o->is_fluent)
+            continue;
+        if (o->fluent >= m_reads.size())
+            m_reads.resize(o->fluent + 1);
+        m_reads[o->fluent].push_back(it->second);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::uint32_t NumericConditions::index_of(const GroundCondition& c) const
+{
+    return m_ids.at(key_of(c));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void NumericConditions::moves(const GroundEffect& e, std::vector<Move>& out) const
+{
+    if (e.kind != GroundEffect::Kind::Numeric || e.fluent >= m_reads.size())
+        return;
+
+    for (auto j : m_reads[e.fluent])
+    {
+        const Condition& nc = m_conditions[j];
+        double step = 0; // One application, unless the effect is a known increment.
+        if (nc.bounded && nc.fluent == e.fluent && !e.value.is_fluent)
+        {
+            const double v = e.value.value;
+            if (e.op == parser::NumericOp::Assign)
+            {
+                if (nc.lower ? v < nc.threshold : v > nc.threshold)
+                    continue;
+            }
+            else
+            {
+                const double delta = (e.op == parser::NumericOp::Decrease) ? -v : v;
+                step = nc.lower ? delta : -delta;
+                if (step <= 0)
+                    continue; // Moves away from the bound.
+            }
+        }
+        out.push_back({ j, step });
+    }
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,86 @@
+/// @file NumericConditions.hpp
+/// Numeric conditions of a task as propositions of the delete relaxation.
+#pragma once
+
+#include "ISolver.hpp"
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// The distinct comparisons of a task (preconditions, effect guards, derived
+/// predicate conditions and goals), numbered from 0, with the numeric effects
+/// that can make them true.
+///
+/// The delete-relaxation heuristics treat each comparison as a proposition
+/// reached by the effects moving one of its fluents towards it.  For a bound
+/// (see as_bound) changed by a constant, increments moving away from the
+/// bound and assignments of a violating value are left out; any other effect
+/// on a fluent read by the comparison may reach it.  No effect that can make
+/// a comparison true is ever left out, so landmarks and cuts built on these
+/// propositions stay sound.
+/// *****************************************************************************
+class NumericConditions
+{
+public:
+
+    /// A comparison and its normalised bound form.
+    struct Condition
+    {
+        GroundCondition cond;  ///< The comparison.
+        bool bounded = false;  ///< True when @c cond is a bound (see as_bound).
+        FluentId fluent = 0;   ///< Bounded fluent.
+        bool lower = true;     ///< Lower bound (@c >=) or upper bound (@c <=).
+        double threshold = 0;  ///< Bound value.
+    };
+
+    /// Progress of an effect towards a comparison.
+    struct Move
+    {
+        std::uint32_t index; ///< Comparison moved towards.
+        double step;         ///< Progress per application (0 = reached in one application).
+    };
+
+    explicit NumericConditions(const SolverContext& ctx);
+
+    /// Number of comparisons.
+    size_t size() const
+    {
+        return m_conditions.size();
+    }
+
+    /// Comparison @p i.
+    const Condition& operator[](size_t i) const
+    {
+        return m_conditions[i];
+    }
+
+    /// Index of comparison @p c, which must appear in the task.
+    std::uint32_t index_of(const GroundCondition& c) const;
+
+    /// Append the comparisons effect @p e moves towards to @p out (none for
+    /// non-numeric effects).
+    void moves(const GroundEffect& e, std::vector<Move>& out) const;
+
+private:
+
+    /// Key identifying a comparison, for deduplication.
+    using Key = std::tuple<Comparator, bool, FluentId, double, bool, FluentId, double>;
+
+    static Key key_of(const GroundCondition& c);
+
+    /// Register comparison @p c if it is new.
+    void collect(const GroundCondition& c);
+
+private:
+
+    std::vector<Condition> m_conditions;             ///< Comparisons, by index.
+    std::map<Key, std::uint32_t> m_ids;              ///< Index of each comparison.
+    std::vector<std::vector<std::uint32_t>> m_reads; ///< Comparisons reading each fluent.
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,254 @@
+/// @file OpenList.hpp
+/// Open-list data structures for the best-first searches.
+#pragma once
+
+#include "SearchNode.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// Data structure holding the open nodes of A*.
+enum class OpenListKind
+{
+    BinaryHeap, ///< Binary heap on the float f-value: O(log n) push / pop, any costs.
+    Buckets,    ///< Integer (f, h) buckets: O(1) push / pop, for small integer costs.
+};
+
+/// Preference among open nodes of equal f.
+enum class TieBreaking
+{
+    None,  ///< No preference: heap order, or insertion order in the buckets.
+    LowH,  ///< Lowest h first: closest to the goal.
+    HighG, ///< Highest g first: deepest node (same as LowH when f ties exactly).
+};
+
+/// Order of the nodes still tied after TieBreaking.
+enum class InsertionOrder
+{
+    Lifo, ///< Newest first: dives towards the goal on plateaus.
+    Fifo, ///< Oldest first.
+};
+
+/// Integer bucket key of a cost: rounded up, so admissible estimates stay admissible with integer action costs.
+/// @p cost must be finite: dead ends are never queued.  Saturates at SIZE_MAX.
+inline size_t bucket_key(float cost)
+{
+    assert(std::isfinite(cost) && cost >= 0);
+    const float key = std::ceil(cost);
+    return key < static_cast<float>(std::numeric_limits<size_t>::max()) ? static_cast<size_t>(key)
+                                                                         : std::numeric_limits<size_t>::max();
+}
+
+/// *****************************************************************************
+/// Two-level bucket queue keyed by small integers (f, h).
+///
+/// Buckets are indexed directly by the keys, so push and pop are O(1) apart
+/// from the cursor moving over empty buckets, which is amortised when f grows
+/// monotonically (consistent heuristics).  Pops take the lowest f, then the
+/// lowest h, then follow @c order within the bucket.  Elements are moved in
+/// and out, never copied.
+///
+/// Memory grows with the largest key, so keys must stay small: typically plan
+/// costs of a few hundred with action costs of 1-4.  push() rejects keys above
+/// MAX_KEY; callers check fits() first and fall back to a heap.
+/// *****************************************************************************
+template <class T>
+class BucketQueue
+{
+public:
+
+    /// Largest key accepted by push().
+    static constexpr size_t MAX_KEY = size_t(1) << 16;
+
+    explicit BucketQueue(InsertionOrder order = InsertionOrder::Lifo) : m_order(order) {}
+
+    /// True if @p f and @p h can be pushed.
+    static bool fits(size_t f, size_t h = 0)
+    {
+        return f <= MAX_KEY && h <= MAX_KEY;
+    }
+
+    /// True if the queue holds no element.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// Number of queued elements.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /// Queue @p value with keys @p f and @p h.
+    /// @throws std::runtime_error If a key exceeds MAX_KEY (see fits()).
+    void push(size_t f, size_t h, T value)
+    {
+        if (!fits(f, h))
+            throw std::runtime_error("bucket queue key (" + std::to_string(f) + ", " + std::to_string(h) +
+                                     ") exceeds the limit of " + std::to_string(MAX_KEY));
+        if (f >= m_buckets.size())
+            m_buckets.resize(f + 1);
+        Level& level = m_buckets[f];
+        if (h >= level.buckets.size())
+            level.buckets.resize(h + 1);
+        level.buckets[h].push_back(std::move(value));
+        if (level.count++ == 0 || h < level.min_h)
+            level.min_h = h;
+        if (m_size++ == 0 || f < m_min_f)
+            m_min_f = f;
+    }
+
+    /// Remove and return the next element (the queue must not be empty).
+    T pop()
+    {
+        while (m_buckets[m_min_f].count == 0)
+            ++m_min_f;
+        Level& level = m_buckets[m_min_f];
+        while (level.buckets[level.min_h].empty())
+            ++level.min_h;
+
+        std::deque<T>& bucket = level.buckets[level.min_h];
+        T value;
+        if (m_order == InsertionOrder::Lifo)
+        {
+            value = std::move(bucket.back());
+            bucket.pop_back();
+        }
+        else
+        {
+            value = std::move(bucket.front());
+            bucket.pop_front();
+        }
+        --level.count;
+        --m_size;
+        return value;
+    }
+
+private:
+
+    /// Buckets sharing one f-value, indexed by h.
+    struct Level
+    {
+        std::vector<std::deque<T>> buckets; ///< Elements by h.
+        size_t count = 0;                   ///< Elements in @c buckets.
+        size_t min_h = 0;                   ///< No element has a lower h.
+    };
+
+    InsertionOrder     m_order;     ///< Order within a bucket.
+    std::vector<Level> m_buckets;   ///< Levels by f.
+    size_t             m_min_f = 0; ///< No element has a lower f.
+    size_t             m_size  = 0; ///< Queued elements.
+};
+
+/// *****************************************************************************
+/// Heap order of the open nodes: f first, then the tie-breaking policy and
+/// the insertion order.  Returns true if @p a comes after @p b.
+/// *****************************************************************************
+struct NodeOrder
+{
+    TieBreaking tie;
+    InsertionOrder order;
+
+    bool operator()(const Node& a, const Node& b) const
+    {
+        if (a.estimated_cost != b.estimated_cost)
+            return a.estimated_cost > b.estimated_cost;
+        if (tie == TieBreaking::None)
+            return false;
+        if (tie == TieBreaking::LowH)
+        {
+            if (a.heuristic != b.heuristic)
+                return a.heuristic > b.heuristic;
+        }
+        else if (a.real_cost != b.real_cost)
+            return a.real_cost < b.real_cost;
+        return (order == InsertionOrder::Lifo) ? a.record < b.record : a.record > b.record;
+    }
+};
+
+/// *****************************************************************************
+/// Open list of the best-first searches, backed by a binary heap or a bucket
+/// queue (see AStarConfig::open_list).  A bucket list turns into a heap, for
+/// the rest of the search, when a node's keys are too large for buckets.
+/// *****************************************************************************
+class OpenList
+{
+public:
+
+    OpenList(OpenListKind kind, TieBreaking tie, InsertionOrder order)
+        : m_kind(kind), m_tie(tie), m_order{ tie, order }, m_buckets(order)
+    {
+    }
+
+    /// True if no node is open.
+    bool empty() const
+    {
+        return m_kind == OpenListKind::Buckets ? m_buckets.empty() : m_heap.empty();
+    }
+
+    /// Number of open nodes.
+    size_t size() const
+    {
+        return m_kind == OpenListKind::Buckets ? m_buckets.size() : m_heap.size();
+    }
+
+    /// Open @p node.
+    void push(Node node)
+    {
+        if (m_kind == OpenListKind::Buckets)
+        {
+            const size_t f = bucket_key(node.estimated_cost);
+            // With integral g and unweighted h, high g and low h are the same order among equal f.
+            const size_t h = (m_tie == TieBreaking::None) ? 0 : bucket_key(node.heuristic);
+            if (BucketQueue<Node>::fits(f, h))
+            {
+                m_buckets.push(f, h, std::move(node));
+                return;
+            }
+            m_kind = OpenListKind::BinaryHeap;
+            while (!m_buckets.empty())
+                push_heap(m_buckets.pop());
+            m_buckets = BucketQueue<Node>(m_order.order);
+        }
+        push_heap(std::move(node));
+    }
+
+    /// Remove and return the best open node (the list must not be empty).
+    Node pop()
+    {
+        if (m_kind == OpenListKind::Buckets)
+            return m_buckets.pop();
+        std::pop_heap(m_heap.begin(), m_heap.end(), m_order);
+        Node node = std::move(m_heap.back());
+        m_heap.pop_back();
+        return node;
+    }
+
+private:
+
+    void push_heap(Node node)
+    {
+        m_heap.push_back(std::move(node));
+        std::push_heap(m_heap.begin(), m_heap.end(), m_order);
+    }
+
+private:
+
+    OpenListKind      m_kind;    ///< Backing structure.
+    TieBreaking       m_tie;     ///< Tie-breaking, for the bucket keys.
+    NodeOrder         m_order;   ///< Heap order.
+    std::vector<Node> m_heap;    ///< Binary heap under @c m_order; nodes are moved in and out.
+    BucketQueue<Node> m_buckets; ///< Bucket queue.
+};
+
+} // namespace pddl::solver
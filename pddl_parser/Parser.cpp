@@ -413,7 +413,10 @@ static Domain parse_domain(const SExpr& root, Lexer& lex)
             // start=1 to skip the ":constants" tag in children[0]
             auto terms = parse_typed_terms(section, lex, /*start=*/1);
             for (const auto& t : terms)
+            {
                 domain.constants.push_back(t.name);
+                domain.constant_types[t.name] = t.type;
+            }
         }
         else if (tagged(section, ":predicates"))
         {
@@ -436,7 +439,12 @@ static Domain parse_domain(const SExpr& root, Lexer& lex)
             if (section.children.size() >= 3)
             {
                 DerivedPredicate dp;
-                dp.head = parse_predicate(section.children[1], lex);
+                const SExpr& head = section.children[1];
+                if (head.is_atom || head.children.empty())
+                    lexer_error(lex, head.line, "expected (:derived (name ?params…) body)");
+                dp.head.name = head.children[0].atom;
+                dp.head.line = head.line;
+                dp.head.args = parse_typed_terms(head, lex, /*start=*/1);
                 dp.body = parse_predicate_list(section.children[2], lex);
                 domain.derived.push_back(std::move(dp));
             }
@@ -451,20 +459,20 @@ static Domain parse_domain(const SExpr& root, Lexer& lex)
 }
 
 /// *****************************************************************************
-/// Parse the :init section into a WorldState.
+/// Parse the :init section into a list of facts and fluent assignments.
 /// *****************************************************************************
-static WorldState parse_init(const SExpr& e, Lexer& lex)
+static std::vector<Predicate> parse_init(const SExpr& e, Lexer& lex)
 {
-    WorldState ws;
+    std::vector<Predicate> init;
     for (size_t i = 1; i < e.children.size(); ++i)
     {
         const SExpr& child = e.children[i];
         // (at t fact) timed initial literals — skip silently
         if (tagged(child, "at"))
             continue;
-        ws.add(parse_predicate(child, lex));
+        init.push_back(parse_predicate(child, lex));
     }
-    return ws;
+    return init;
 }
 
 /// *****************************************************************************
@@ -489,9 +497,13 @@ static Problem parse_problem(SExpr const& root, Lexer& lex)
         }
         else if (tagged(section, ":objects"))
         {
-            auto terms = parse_typed_terms(section, lex);
+            // start=1 to skip the ":objects" tag in children[0]
+            auto terms = parse_typed_terms(section, lex, /*start=*/1);
             for (const auto& t : terms)
+            {
                 problem.objects.push_back(t.name);
+                problem.object_types[t.name] = t.type;
+            }
         }
         else if (tagged(section, ":init"))
         {
@@ -519,6 +531,50 @@ static Problem parse_problem(SExpr const& root, Lexer& lex)
     return problem;
 }
 
+/// *****************************************************************************
+/// Intern the identifiers declared by a domain: types, constants, predicate
+/// and function names.
+/// *****************************************************************************
+static void intern_domain_symbols(Domain& domain)
+{
+    SymbolTable& symbols = *domain.symbols;
+    for (const auto& t : domain.types)
+        symbols.intern(t.name);
+    for (const auto& c : domain.constants)
+        symbols.intern(c);
+    for (const auto& p : domain.predicates)
+        symbols.intern(p.name);
+    for (const auto& f : domain.functions)
+        symbols.intern(f.name);
+}
+
+/// *****************************************************************************
+/// Intern the identifiers declared by a problem: objects and the predicate,
+/// function and argument names of the initial facts.
+/// *****************************************************************************
+static void intern_problem_symbols(Problem& problem)
+{
+    SymbolTable& symbols = *problem.symbols;
+    for (const auto& o : problem.objects)
+        symbols.intern(o);
+    for (const auto& fact : problem.init)
+    {
+        if (fact.name == "=" && !fact.args.empty())
+        {
+            if (const auto* ref = std::get_if<FluentRef>(&fact.args[0].numeric))
+            {
+                symbols.intern(ref->func);
+                for (const auto& a : ref->args)
+                    symbols.intern(a);
+            }
+            continue;
+        }
+        symbols.intern(fact.name);
+        for (const auto& a : fact.args)
+            symbols.intern(a.name);
+    }
+}
+
 /// *****************************************************************************
 /// Read the entire contents of a file into a string.
 /// *****************************************************************************
@@ -538,16 +594,21 @@ Domain load_domain(std::filesystem::path const& path)
     std::string src = read_file(path);
     Lexer lex{ src, path };
     SExpr root = parse_sexpr(lex);
-    return parse_domain(root, lex);
+    Domain domain = parse_domain(root, lex);
+    intern_domain_symbols(domain);
+    return domain;
 }
 
 // ******************************************************************************
-Problem load_problem(std::filesystem::path const& path)
+Problem load_problem(std::filesystem::path const& path, std::shared_ptr<SymbolTable> symbols)
 {
     std::string src = read_file(path);
     Lexer lex{ src, path };
     SExpr root = parse_sexpr(lex);
-    return parse_problem(root, lex);
+    Problem problem = parse_problem(root, lex);
+    problem.symbols = symbols ? std::move(symbols) : std::make_shared<SymbolTable>();
+    intern_problem_symbols(problem);
+    return problem;
 }
 
 } // namespace pddl::parser
@@ -23,9 +23,12 @@ Domain load_domain(std::filesystem::path const& path);
 
 /// *****************************************************************************
 /// Load and parse a PDDL problem file.
-/// @param path  Filesystem path to the problem file.
+/// @param path     Filesystem path to the problem file.
+/// @param symbols  Identifier table to intern objects into; pass the domain's
+///                 @c Domain::symbols so both files share IDs.  A fresh table
+///                 is created when null.
 /// @return Parsed Problem structure.
 /// *****************************************************************************
-Problem load_problem(std::filesystem::path const& path);
+Problem load_problem(std::filesystem::path const& path, std::shared_ptr<SymbolTable> symbols = nullptr);
 
 } // namespace pddl::parser
@@ -0,0 +1,458 @@
+#include "PatternDatabase.hpp"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+
+namespace pddl::solver
+{
+
+/// Largest domain of a pattern variable (values are bits of a 64-bit mask).
+static constexpr std::uint32_t MAX_DOMAIN = 64;
+
+/// Mask of all the values of a variable.
+static std::uint64_t full_mask(const PatternVariable& v)
+{
+    const std::uint32_t n = v.domain_size();
+    return (n >= 64) ? ~std::uint64_t(0) : (std::uint64_t(1) << n) - 1;
+}
+
+/// Lower end of region @p r of a fluent variable (inclusive).
+static double region_lo(const PatternVariable& v, std::uint32_t r)
+{
+    return (r == 0) ? -std::numeric_limits<double>::infinity() : v.cuts[r - 1];
+}
+
+/// Upper end of region @p r of a fluent variable (exclusive).
+static double region_hi(const PatternVariable& v, std::uint32_t r)
+{
+    return (r == v.cuts.size()) ? std::numeric_limits<double>::infinity() : v.cuts[r];
+}
+
+/// Region of a fluent variable containing @p value.
+static std::uint32_t region_of(const PatternVariable& v, double value)
+{
+    return static_cast<std::uint32_t>(std::upper_bound(v.cuts.begin(), v.cuts.end(), value) - v.cuts.begin());
+}
+
+/// Call @p fn on every condition of the task that tests the state.
+template <class Fn>
+static void for_each_condition(const SolverContext& ctx, Fn&& fn)
+{
+    for (const auto& action : ctx.actions)
+    {
+        for (const auto& c : action.preconditions)
+            fn(c);
+        for (const auto& e : action.effects)
+            if (e.when)
+                fn(*e.when);
+    }
+    for (const auto& g : ctx.goals)
+        fn(g);
+    for (const auto& gdp : ctx.derived)
+        for (const auto& c : gdp.conditions)
+            fn(c);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::vector<PatternVariable> select_pattern(const SolverContext& ctx, size_t max_size, std::uint32_t max_regions)
+{
+    max_regions = std::clamp<std::uint32_t>(max_regions, 2, MAX_DOMAIN);
+
+    std::set<AtomId> derived;
+    for (const auto& gdp : ctx.derived)
+        derived.insert(gdp.head);
+
+    std::map<FluentId, std::vector<double>> thresholds;
+    for_each_condition(ctx, [&](const GroundCondition& c)
+    {
+        FluentId fluent;
+        bool lower;
+        double threshold;
+        if (as_bound(c, fluent, lower, threshold))
+            thresholds[fluent].push_back(threshold);
+    });
+
+    auto fluent_variable = [&](FluentId fluent)
+    {
+        PatternVariable v;
+        v.is_fluent = true;
+        v.fluent = fluent;
+        std::vector<double> cuts = thresholds[fluent];
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+        // Too many thresholds: keep an evenly spread subset (coarser, still sound).
+        if (cuts.size() + 1 > max_regions)
+        {
+            std::vector<double> kept;
+            for (std::uint32_t i = 0; i + 1 < max_regions; ++i)
+                kept.push_back(cuts[i * cuts.size() / (max_regions - 1)]);
+            cuts.swap(kept);
+        }
+
+        // Refine the range between the initial value and the thresholds with a uniform grid.
+        const double init = ctx.initial.get_fluent(fluent);
+        const double lo = cuts.empty() ? init : std::min(init, cuts.front());
+        const double hi = cuts.empty() ? init : std::max(init, cuts.back());
+        const std::uint32_t spare = max_regions - 1 - static_cast<std::uint32_t>(cuts.size());
+        if (hi > lo && spare > 0)
+        {
+            const double step = (hi - lo) / (spare + 1);
+            for (std::uint32_t i = 1; i <= spare; ++i)
+                cuts.push_back(lo + i * step);
+            std::sort(cuts.begin(), cuts.end());
+            cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+        }
+        v.cuts = std::move(cuts);
+        return v;
+    };
+
+    std::vector<PatternVariable> pattern;
+    std::set<std::pair<bool, std::uint32_t>> seen;
+    size_t size = 1;
+    auto consider = [&](bool is_fluent, std::uint32_t id)
+    {
+        if (!is_fluent && derived.count(id))
+            return;
+        if (!seen.insert({ is_fluent, id }).second)
+            return;
+        PatternVariable v;
+        if (is_fluent)
+            v = fluent_variable(id);
+        else
+            v.atom = id;
+        if (size * v.domain_size() > max_size)
+            return;
+        size *= v.domain_size();
+        pattern.push_back(std::move(v));
+    };
+    auto consider_condition = [&](const GroundCondition& c)
+    {
+        if (c.kind != GroundCondition::Kind::Compare)
+            consider(false, c.atom);
+        else
+        {
+            if (c.lhs.is_fluent)
+                consider(true, c.lhs.fluent);
+            if (c.rhs.is_fluent)
+                consider(true, c.rhs.fluent);
+        }
+    };
+
+    for (const auto& g : ctx.goals)
+        consider_condition(g);
+
+    // Grow the pattern with the causes of its variables, breadth first.
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        const PatternVariable var = pattern[i];
+        for (const auto& action : ctx.actions)
+        {
+            const bool changes = std::any_of(action.effects.begin(), action.effects.end(), [&](const GroundEffect& e)
+            {
+                return var.is_fluent ? (e.kind == GroundEffect::Kind::Numeric && e.fluent == var.fluent)
+                                     : (e.kind != GroundEffect::Kind::Numeric && e.atom == var.atom);
+            });
+            if (!changes)
+                continue;
+            for (const auto& c : action.preconditions)
+                consider_condition(c);
+            for (const auto& e : action.effects)
+                if (e.when)
+                    consider_condition(*e.when);
+        }
+    }
+    return pattern;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+PatternDatabase::PatternDatabase(const SolverContext& ctx, std::vector<PatternVariable> pattern)
+    : m_pattern(std::move(pattern))
+{
+    size_t size = 1;
+    for (const auto& v : m_pattern)
+    {
+        m_stride.push_back(size);
+        size *= v.domain_size();
+    }
+
+    // Abstract operators: only actions changing a pattern variable move in the abstraction.
+    for (const auto& action : ctx.actions)
+    {
+        Operator op;
+        op.cost = static_cast<float>(action.cost);
+        op.pre.resize(m_pattern.size());
+        for (size_t v = 0; v < m_pattern.size(); ++v)
+            op.pre[v] = full_mask(m_pattern[v]);
+        for (const auto& c : action.preconditions)
+        {
+            std::int32_t var;
+            const std::uint64_t mask = mask_of(c, var);
+            if (var >= 0)
+                op.pre[var] &= mask;
+        }
+        if (std::find(op.pre.begin(), op.pre.end(), 0) != op.pre.end())
+            continue;
+
+        for (const auto& e : action.effects)
+        {
+            Operator::Effect eff;
+            std::int32_t var = (e.kind == GroundEffect::Kind::Numeric) ? find_fluent(e.fluent) : find_atom(e.atom);
+            if (var < 0)
+                continue;
+            const PatternVariable& v = m_pattern[var];
+            eff.var = static_cast<std::uint32_t>(var);
+            eff.image.assign(v.domain_size(), full_mask(v));
+            if (e.kind != GroundEffect::Kind::Numeric)
+                eff.image.assign(2, std::uint64_t(e.kind == GroundEffect::Kind::Add ? 2 : 1));
+            else if (e.op == parser::NumericOp::Assign && !e.value.is_fluent)
+                eff.image.assign(v.domain_size(), std::uint64_t(1) << region_of(v, e.value.value));
+            else if ((e.op == parser::NumericOp::Increase || e.op == parser::NumericOp::Decrease) &&
+                     !e.value.is_fluent)
+            {
+                // Region r moves to every region overlapping [lo + delta, hi + delta).
+                const double delta = (e.op == parser::NumericOp::Increase) ? e.value.value : -e.value.value;
+                for (std::uint32_t r = 0; r < v.domain_size(); ++r)
+                {
+                    const double lo = region_lo(v, r) + delta;
+                    const double hi = region_hi(v, r) + delta;
+                    std::uint64_t mask = 0;
+                    for (std::uint32_t j = 0; j < v.domain_size(); ++j)
+                        if (region_lo(v, j) < hi && region_hi(v, j) > lo)
+                            mask |= std::uint64_t(1) << j;
+                    eff.image[r] = mask;
+                }
+            }
+            if (e.when)
+            {
+                eff.guarded = true;
+                eff.guard_mask = mask_of(*e.when, eff.guard_var);
+            }
+            op.effects.push_back(std::move(eff));
+        }
+        for (const auto& eff : op.effects)
+            if (!op.touches(eff.var))
+                op.touched.push_back(eff.var);
+        if (!op.effects.empty())
+            m_ops.push_back(std::move(op));
+    }
+
+    // Reverse transition graph in compressed form: predecessors of each state.
+    std::vector<std::uint32_t> first(size + 1, 0);
+    for_each_transition(size, [&](size_t, size_t to, float) { ++first[to + 1]; });
+    for (size_t s = 0; s < size; ++s)
+        first[s + 1] += first[s];
+    std::vector<std::pair<std::uint32_t, float>> preds(first[size]);
+    std::vector<std::uint32_t> fill(first.begin(), first.end() - 1);
+    for_each_transition(size, [&](size_t from, size_t to, float cost)
+    {
+        preds[fill[to]++] = { static_cast<std::uint32_t>(from), cost };
+    });
+
+    // Abstract goal states.
+    std::vector<std::uint64_t> goal(m_pattern.size());
+    for (size_t v = 0; v < m_pattern.size(); ++v)
+        goal[v] = full_mask(m_pattern[v]);
+    for (const auto& g : ctx.goals)
+    {
+        std::int32_t var;
+        const std::uint64_t mask = mask_of(g, var);
+        if (var >= 0)
+            goal[var] &= mask;
+    }
+
+    using Entry = std::pair<float, std::uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    m_table.assign(size, DEAD_END);
+    std::vector<std::uint32_t> value(m_pattern.size(), 0);
+    for (size_t s = 0; s < size; ++s)
+    {
+        bool is_goal = true;
+        for (size_t v = 0; v < m_pattern.size() && is_goal; ++v)
+            is_goal = (goal[v] >> value[v]) & 1u;
+        if (is_goal)
+        {
+            m_table[s] = 0;
+            open.emplace(0.0f, static_cast<std::uint32_t>(s));
+        }
+        for (size_t v = 0; v < m_pattern.size() && ++value[v] == m_pattern[v].domain_size(); ++v)
+            value[v] = 0;
+    }
+
+    while (!open.empty())
+    {
+        const auto [d, s] = open.top();
+        open.pop();
+        if (d > m_table[s])
+            continue;
+        for (std::uint32_t i = first[s]; i < first[s + 1]; ++i)
+        {
+            const auto [from, cost] = preds[i];
+            if (d + cost < m_table[from])
+            {
+                m_table[from] = d + cost;
+                open.emplace(d + cost, from);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::int32_t PatternDatabase::find_atom(AtomId atom) const
+{
+    for (size_t v = 0; v < m_pattern.size(); ++v)
+        if (!m_pattern[v].is_fluent && m_pattern[v].atom == atom)
+            return static_cast<std::int32_t>(v);
+    return -1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::int32_t PatternDatabase::find_fluent(FluentId fluent) const
+{
+    for (size_t v = 0; v < m_pattern.size(); ++v)
+        if (m_pattern[v].is_fluent && m_pattern[v].fluent == fluent)
+            return static_cast<std::int32_t>(v);
+    return -1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::uint64_t PatternDatabase::mask_of(const GroundCondition& c, std::int32_t& var) const
+{
+    var = -1;
+    if (c.kind != GroundCondition::Kind::Compare)
+    {
+        var = find_atom(c.atom);
+        return (c.kind == GroundCondition::Kind::Fact) ? 2 : 1;
+    }
+
+    FluentId fluent;
+    bool lower;
+    double threshold;
+    if (!as_bound(c, fluent, lower, threshold) || (var = find_fluent(fluent)) < 0)
+        return ~std::uint64_t(0);
+
+    // A region qualifies when some of its values satisfy the bound.
+    const PatternVariable& v = m_pattern[var];
+    std::uint64_t mask = 0;
+    for (std::uint32_t r = 0; r < v.domain_size(); ++r)
+        if (lower ? region_hi(v, r) > threshold : region_lo(v, r) <= threshold)
+            mask |= std::uint64_t(1) << r;
+    return mask;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+size_t PatternDatabase::index_of(const WorldState& ws) const
+{
+    size_t index = 0;
+    for (size_t v = 0; v < m_pattern.size(); ++v)
+    {
+        const PatternVariable& var = m_pattern[v];
+        const std::uint32_t value = var.is_fluent ? region_of(var, ws.get_fluent(var.fluent)) : ws.holds(var.atom);
+        index += value * m_stride[v];
+    }
+    return index;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <class EdgeFn>
+void PatternDatabase::for_each_transition(size_t size, EdgeFn&& edge) const
+{
+    const size_t n = m_pattern.size();
+    std::vector<std::uint32_t> value(n, 0);
+    std::vector<std::uint64_t> reach(n);
+
+    std::vector<std::uint64_t> left(n);
+    for (size_t s = 0; s < size; ++s)
+    {
+        for (const auto& op : m_ops)
+        {
+            bool applicable = true;
+            for (size_t v = 0; v < n && applicable; ++v)
+                applicable = (op.pre[v] >> value[v]) & 1u;
+            if (!applicable)
+                continue;
+
+            for (auto v : op.touched)
+                reach[v] = std::uint64_t(1) << value[v];
+            for (const auto& eff : op.effects)
+            {
+                bool may_fire = true;
+                bool may_skip = false;
+                if (eff.guarded)
+                {
+                    may_skip = true;
+                    if (eff.guard_var >= 0)
+                    {
+                        const std::uint64_t guard = (std::uint64_t(1) << value[eff.guard_var]);
+                        const std::uint64_t now = op.touches(static_cast<std::uint32_t>(eff.guard_var)) ? reach[eff.guard_var] : guard;
+                        may_fire = (now & eff.guard_mask) != 0;
+                        may_skip = (now & ~eff.guard_mask) != 0;
+                    }
+                }
+                if (!may_fire)
+                    continue;
+                std::uint64_t image = 0;
+                for (std::uint64_t bits = reach[eff.var]; bits != 0; bits &= bits - 1)
+                    image |= eff.image[std::countr_zero(bits)];
+                reach[eff.var] = may_skip ? (reach[eff.var] | image) : image;
+            }
+
+            // One transition per combination of the reachable values of the touched variables.
+            size_t base = s;
+            for (auto v : op.touched)
+            {
+                base -= value[v] * m_stride[v];
+                left[v] = reach[v];
+            }
+            for (;;)
+            {
+                size_t to = base;
+                for (auto v : op.touched)
+                    to += static_cast<size_t>(std::countr_zero(left[v])) * m_stride[v];
+                if (to != s)
+                    edge(s, to, op.cost);
+
+                size_t i = 0;
+                for (; i < op.touched.size(); ++i)
+                {
+                    const auto v = op.touched[i];
+                    left[v] &= left[v] - 1;
+                    if (left[v] != 0)
+                        break;
+                    left[v] = reach[v];
+                }
+                if (i == op.touched.size())
+                    break;
+            }
+        }
+        for (size_t v = 0; v < n && ++value[v] == m_pattern[v].domain_size(); ++v)
+            value[v] = 0;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<const PatternDatabase> pattern_database_of(const SolverContext& ctx)
+{
+    auto build = [&]
+    {
+        return std::make_shared<const PatternDatabase>(
+            ctx, select_pattern(ctx, PatternDatabase::DEFAULT_MAX_SIZE, PatternDatabase::DEFAULT_MAX_REGIONS));
+    };
+    if (!ctx.cache)
+        return build();
+    std::lock_guard lock(ctx.cache->mutex);
+    if (!ctx.cache->patterns)
+        ctx.cache->patterns = build();
+    return ctx.cache->patterns;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+PatternDatabaseHeuristic::PatternDatabaseHeuristic(const SolverContext& ctx) : m_pdb(pattern_database_of(ctx))
+{
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,161 @@
+/// @file PatternDatabase.hpp
+/// Pattern database: abstract goal distances precomputed once per task.
+#pragma once
+
+#include "Heuristic.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// One variable of a pattern: a fact, or a fluent split into value regions.
+///
+/// A fluent variable with cuts @c t1 < ... < tk has the k + 1 regions
+/// @c (-inf, t1), @c [t1, t2), ..., @c [tk, +inf).
+/// *****************************************************************************
+struct PatternVariable
+{
+    bool                is_fluent = false; ///< Fluent variable (else fact variable).
+    AtomId              atom      = 0;     ///< Projected atom of a fact variable.
+    FluentId            fluent    = 0;     ///< Projected fluent of a fluent variable.
+    std::vector<double> cuts;              ///< Region boundaries of a fluent variable, ascending.
+
+    /// Number of abstract values (2 for a fact).
+    std::uint32_t domain_size() const
+    {
+        return is_fluent ? static_cast<std::uint32_t>(cuts.size() + 1) : 2;
+    }
+};
+
+/// Pick a pattern for @p ctx whose abstract state space has at most
+/// @p max_size states: the goal variables first, then the variables the
+/// actions changing pattern variables depend on, breadth first.
+///
+/// Fluent regions are cut at every threshold the task compares the fluent
+/// with, refined by a uniform grid up to @p max_regions regions.
+std::vector<PatternVariable> select_pattern(const SolverContext& ctx, size_t max_size, std::uint32_t max_regions);
+
+/// *****************************************************************************
+/// Projection of the task onto a pattern, with the cost of the cheapest
+/// abstract plan from every abstract state stored in a flat table.
+///
+/// The abstraction over-approximates the task: conditions on variables outside
+/// the pattern are dropped, an effect moving a fluent region may land in any
+/// region the shifted interval overlaps, and conditional effects whose guard
+/// is undetermined both fire and not.  Every concrete transition thus has an
+/// abstract counterpart and the stored distances are admissible.  Derived
+/// atoms are never projected.
+///
+/// The table is filled once by a Dijkstra search backward from the abstract
+/// goal states; a lookup projects the state, which is one bit test per fact
+/// variable and one binary search per fluent variable.
+/// *****************************************************************************
+class PatternDatabase
+{
+public:
+
+    /// Default limit on the number of abstract states.
+    static constexpr size_t DEFAULT_MAX_SIZE = size_t(1) << 14;
+
+    /// Default number of regions per fluent variable.
+    static constexpr std::uint32_t DEFAULT_MAX_REGIONS = 32;
+
+    /// Build the database of @p ctx projected onto @p pattern.
+    PatternDatabase(const SolverContext& ctx, std::vector<PatternVariable> pattern);
+
+    /// Abstract goal distance of @p ws, or DEAD_END.
+    float distance(const WorldState& ws) const
+    {
+        return m_table[index_of(ws)];
+    }
+
+    /// Projected variables.
+    const std::vector<PatternVariable>& pattern() const
+    {
+        return m_pattern;
+    }
+
+    /// Number of abstract states.
+    size_t size() const
+    {
+        return m_table.size();
+    }
+
+private:
+
+    /// Abstract action: value masks required by the precondition and the
+    /// effects on pattern variables, in application order.
+    struct Operator
+    {
+        /// Effect on one pattern variable.
+        struct Effect
+        {
+            std::uint32_t              var        = 0;     ///< Pattern variable.
+            std::vector<std::uint64_t> image;              ///< Possible new values for each old value.
+            bool                       guarded    = false; ///< Conditional effect.
+            std::int32_t               guard_var  = -1;    ///< Pattern variable of the guard, -1 if undetermined.
+            std::uint64_t              guard_mask = 0;     ///< Values of @c guard_var satisfying the guard.
+        };
+
+        std::vector<std::uint64_t> pre;      ///< Allowed values per pattern variable.
+        std::vector<Effect>        effects;  ///< Effects on pattern variables.
+        std::vector<std::uint32_t> touched;  ///< Variables changed by @c effects.
+        float                      cost = 0; ///< Action cost.
+
+        /// True if the operator changes variable @p var.
+        bool touches(std::uint32_t var) const
+        {
+            return std::find(touched.begin(), touched.end(), var) != touched.end();
+        }
+    };
+
+    /// Index of the pattern variable projecting @p atom / @p fluent, or -1.
+    std::int32_t find_atom(AtomId atom) const;
+    std::int32_t find_fluent(FluentId fluent) const;
+
+    /// Mask of the values of @p var for which @p c may hold (all values if @p c does not constrain @p var).
+    std::uint64_t mask_of(const GroundCondition& c, std::int32_t& var) const;
+
+    /// Abstract table index of @p ws.
+    size_t index_of(const WorldState& ws) const;
+
+    /// Call @p edge(from, to, cost) for every abstract transition of the @p size states.
+    template <class EdgeFn>
+    void for_each_transition(size_t size, EdgeFn&& edge) const;
+
+private:
+
+    std::vector<PatternVariable> m_pattern; ///< Projected variables.
+    std::vector<size_t>          m_stride;  ///< Table stride of each variable.
+    std::vector<Operator>        m_ops;     ///< Abstract operators.
+    std::vector<float>           m_table;   ///< Goal distance per abstract state.
+};
+
+/// Pattern database of @p ctx with the default limits, built on the first
+/// call and cached in @c ctx.cache for later solves.  Thread-safe.
+std::shared_ptr<const PatternDatabase> pattern_database_of(const SolverContext& ctx);
+
+/// *****************************************************************************
+/// Admissible heuristic reading the cached pattern database of the task.
+/// *****************************************************************************
+class PatternDatabaseHeuristic: public IHeuristic
+{
+public:
+
+    explicit PatternDatabaseHeuristic(const SolverContext& ctx);
+
+    /// @copydoc IHeuristic::evaluate
+    float evaluate(const WorldState& ws) override
+    {
+        return m_pdb->distance(ws);
+    }
+
+private:
+
+    std::shared_ptr<const PatternDatabase> m_pdb;
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,120 @@
+#include "PortfolioSolver.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <thread>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+PortfolioSolver& PortfolioSolver::add(std::string name, std::unique_ptr<ISolver> solver)
+{
+    m_members.push_back({ std::move(name), std::move(solver) });
+    return *this;
+}
+
+/// *****************************************************************************
+/// ISolver::solve implementation
+/// *****************************************************************************
+PlanResult PortfolioSolver::solve(const SolverContext& ctx)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto& cfg = m_config;
+    const size_t n = m_members.size();
+    m_winner.clear();
+
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    // Members see the portfolio's token, which also follows the caller's.
+    std::stop_source stop;
+    std::stop_callback forward(ctx.stop, [&]
+    {
+        stop.request_stop();
+        std::lock_guard lock(mutex); // Wakes the wait below even if it is about to sleep.
+        changed.notify_all();
+    });
+    SolverContext member_ctx = ctx;
+    member_ctx.stop = stop.get_token();
+    member_ctx.progress = nullptr; // Members run concurrently.
+
+    std::vector<PlanResult> results(n);
+    std::vector<size_t> finished; ///< Members in completion order.
+    bool settled = false;         ///< FirstPlan: a member found a plan.
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < n; ++i)
+        threads.emplace_back([&, i]
+        {
+            PlanResult result = m_members[i].solver->solve(member_ctx);
+            std::lock_guard lock(mutex);
+            if (cfg.verbose)
+                std::cerr << "[portfolio] " << m_members[i].name << ": "
+                          << (result.success ? "plan of cost " + std::to_string(result.cost) : std::string("no plan"))
+                          << " after " << result.iterations << " iterations ("
+                          << stop_reason_name(result.stop_reason) << ")\n";
+            if (result.success && cfg.mode == PortfolioMode::FirstPlan && !settled)
+            {
+                settled = true;
+                stop.request_stop();
+            }
+            results[i] = std::move(result);
+            finished.push_back(i);
+            changed.notify_all();
+        });
+
+    // The members also see ctx.deadline; the portfolio only needs it to stop waiting.
+    std::optional<Clock::time_point> deadline = ctx.deadline;
+    if (cfg.time_limit.count() > 0)
+        deadline = std::min(deadline.value_or(Clock::time_point::max()), Clock::now() + cfg.time_limit);
+
+    bool timed_out = false;
+    {
+        std::unique_lock lock(mutex);
+        auto over = [&] { return settled || finished.size() == n || stop.stop_requested(); };
+        if (deadline)
+            timed_out = !changed.wait_until(lock, *deadline, over);
+        else
+            changed.wait(lock, over);
+    }
+    stop.request_stop();
+    for (auto& t : threads)
+        t.join();
+
+    // First plan in completion order, or the cheapest one (earliest on ties).
+    PlanResult* best = nullptr;
+    size_t total_iterations = 0;
+    for (size_t i : finished)
+    {
+        total_iterations += results[i].iterations;
+        if (results[i].success && (!best || (cfg.mode == PortfolioMode::BestPlan && results[i].cost < best->cost)))
+        {
+            best = &results[i];
+            m_winner = m_members[i].name;
+        }
+    }
+
+    if (!best)
+    {
+        // The portfolio's own stop, else exhaustion by any member, else the last member's limit.
+        PlanResult result;
+        result.final_state = ctx.initial;
+        result.iterations = total_iterations;
+        if (ctx.stop.stop_requested())
+            result.stop_reason = StopReason::Cancelled;
+        else if (timed_out)
+            result.stop_reason = StopReason::Deadline;
+        else if (std::any_of(results.begin(), results.end(),
+                             [](const PlanResult& r) { return r.stop_reason == StopReason::Exhausted; }))
+            result.stop_reason = StopReason::Exhausted;
+        else
+            result.stop_reason = finished.empty() ? StopReason::Exhausted : results[finished.back()].stop_reason;
+        return result;
+    }
+    PlanResult result = std::move(*best);
+    result.iterations = total_iterations;
+    return result;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,82 @@
+/// @file PortfolioSolver.hpp
+/// Planner racing several solver configurations on the same task.
+#pragma once
+
+#include "ISolver.hpp"
+#include <chrono>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Result selection of the portfolio.
+/// *****************************************************************************
+enum class PortfolioMode
+{
+    FirstPlan, ///< Return the first plan found and cancel the other members.
+    BestPlan,  ///< Return the cheapest plan found by the deadline, or once every member is done.
+};
+
+/// *****************************************************************************
+/// Configuration for the portfolio planner.
+/// *****************************************************************************
+struct PortfolioConfig
+{
+    PortfolioMode mode = PortfolioMode::FirstPlan; ///< Result selection.
+    std::chrono::milliseconds time_limit{ 0 };     ///< Members still running are then cancelled (0 = none).
+    bool verbose = false;                          ///< Print the outcome of every member.
+};
+
+/// *****************************************************************************
+/// Portfolio of planners raced on the same SolverContext.
+///
+/// Every member runs on its own thread with a stop token of the portfolio;
+/// the losers are cancelled cooperatively (see SolverContext::stop) as soon as
+/// the result is settled, and the portfolio returns once all of them are
+/// joined.  A stop requested on the caller's context is forwarded to the
+/// members, which also share its deadline and the analyses in
+/// SolverContext::cache.
+///
+/// The returned PlanResult is the winner's, except @c iterations which adds
+/// up the work of every member.
+/// *****************************************************************************
+class PortfolioSolver: public ISolver
+{
+public:
+
+    explicit PortfolioSolver(PortfolioConfig cfg = {}) : m_config(std::move(cfg)) {}
+
+    /// Add a member under @p name (used by winner() and the verbose output).
+    /// Members must not share mutable state, as they run concurrently.
+    PortfolioSolver& add(std::string name, std::unique_ptr<ISolver> solver);
+
+    /// Number of members.
+    size_t size() const
+    {
+        return m_members.size();
+    }
+
+    /// Name of the member whose plan the last solve() returned (empty if none).
+    const std::string& winner() const
+    {
+        return m_winner;
+    }
+
+    /// @copydoc ISolver::solve
+    PlanResult solve(const SolverContext& ctx) override;
+
+private:
+
+    /// A named member planner.
+    struct Member
+    {
+        std::string name;               ///< Label of the configuration.
+        std::unique_ptr<ISolver> solver; ///< The planner.
+    };
+
+    PortfolioConfig m_config;      ///< Result selection and deadline.
+    std::vector<Member> m_members; ///< Raced planners.
+    std::string m_winner;          ///< Member of the last returned plan.
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,252 @@
+#include "RelaxedHeuristic.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+RelaxedHeuristic::RelaxedHeuristic(const SolverContext& ctx, Mode mode)
+    : m_mode(mode), m_atom_count(static_cast<std::uint32_t>(ctx.atoms.atom_count())), m_numeric(ctx),
+      m_min_ratio(m_numeric.size(), DEAD_END)
+{
+    // Negative facts are relaxed away.
+    auto proposition = [&](const GroundCondition& c)
+    {
+        switch (c.kind)
+        {
+            case GroundCondition::Kind::Fact:
+                return c.atom;
+            case GroundCondition::Kind::NotFact:
+                return NONE;
+            case GroundCondition::Kind::Compare:
+                break;
+        }
+        return m_atom_count + m_numeric.index_of(c);
+    };
+    auto props_of = [&](const std::vector<GroundCondition>& conds)
+    {
+        std::vector<std::uint32_t> props;
+        for (const auto& c : conds)
+            if (auto p = proposition(c); p != NONE)
+                props.push_back(p);
+        std::sort(props.begin(), props.end());
+        props.erase(std::unique(props.begin(), props.end()), props.end());
+        return props;
+    };
+
+    for (std::uint32_t a = 0; a < ctx.actions.size(); ++a)
+    {
+        const GroundAction& action = ctx.actions[a];
+        Operator base;
+        base.pre = props_of(action.preconditions);
+        base.cost = static_cast<float>(action.cost);
+        base.action = a;
+
+        std::vector<const GroundEffect*> unconditional;
+        for (const auto& e : action.effects)
+        {
+            if (!e.when)
+            {
+                unconditional.push_back(&e);
+                continue;
+            }
+            Operator op = base;
+            if (auto p = proposition(*e.when); p != NONE && !std::binary_search(op.pre.begin(), op.pre.end(), p))
+                op.pre.insert(std::lower_bound(op.pre.begin(), op.pre.end(), p), p);
+            add_operator(std::move(op), { &e });
+        }
+        add_operator(std::move(base), unconditional);
+    }
+    for (const auto& gdp : ctx.derived)
+    {
+        Operator op;
+        op.pre = props_of(gdp.conditions);
+        op.add.push_back(gdp.head);
+        add_operator(std::move(op), {});
+    }
+
+    const size_t props = m_atom_count + m_numeric.size();
+    m_readers.resize(props);
+    for (std::uint32_t op = 0; op < m_ops.size(); ++op)
+    {
+        for (auto p : m_ops[op].pre)
+            m_readers[p].push_back(op);
+        if (m_ops[op].pre.empty())
+            m_free_ops.push_back(op);
+    }
+
+    m_is_goal.assign(props, 0);
+    m_goals = props_of(ctx.goals);
+    for (auto g : m_goals)
+        m_is_goal[g] = 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void RelaxedHeuristic::add_operator(Operator op, const std::vector<const GroundEffect*>& effects)
+{
+    for (const GroundEffect* e : effects)
+    {
+        if (e->kind == GroundEffect::Kind::Add)
+        {
+            op.add.push_back(e->atom);
+            continue;
+        }
+        const size_t first = op.numeric.size();
+        m_numeric.moves(*e, op.numeric);
+        for (size_t i = first; i < op.numeric.size(); ++i)
+        {
+            auto& [j, step] = op.numeric[i];
+            m_min_ratio[j] = std::min(m_min_ratio[j], step > 0 ? op.cost / static_cast<float>(step) : 0.0f);
+            j += m_atom_count;
+        }
+    }
+    m_ops.push_back(std::move(op));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void RelaxedHeuristic::relax(std::uint32_t p, float cost, std::uint32_t op, std::uint32_t reps)
+{
+    if (cost >= m_cost[p])
+        return;
+    m_cost[p] = cost;
+    m_supporter[p] = op;
+    m_reps[p] = reps;
+    m_queue.emplace_back(cost, p);
+    std::push_heap(m_queue.begin(), m_queue.end(), std::greater<>());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void RelaxedHeuristic::enable(std::uint32_t o)
+{
+    const Operator& op = m_ops[o];
+    const float pre_cost = m_pre_cost[o];
+    for (auto a : op.add)
+        relax(a, pre_cost + op.cost, o, 1);
+
+    for (const auto& [p, step] : op.numeric)
+    {
+        if (m_cost[p] == 0)
+            continue;
+        const double gap = m_gap[p - m_atom_count];
+        if (m_mode == Mode::Max)
+        {
+            const float progress = static_cast<float>(gap) * m_min_ratio[p - m_atom_count];
+            relax(p, pre_cost + std::max(op.cost, progress), o, 1);
+        }
+        else
+        {
+            const double reps = (step > 0) ? std::clamp(std::ceil(gap / step), 1.0, 1e9) : 1.0;
+            relax(p, pre_cost + static_cast<float>(reps) * op.cost, o, static_cast<std::uint32_t>(reps));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float RelaxedHeuristic::evaluate(const WorldState& ws)
+{
+    const size_t props = m_atom_count + m_numeric.size();
+    m_cost.assign(props, DEAD_END);
+    m_supporter.assign(props, NONE);
+    m_reps.assign(props, 0);
+    m_closed.assign(props, 0);
+    m_pre_cost.assign(m_ops.size(), 0);
+    m_missing.resize(m_ops.size());
+    for (size_t o = 0; o < m_ops.size(); ++o)
+        m_missing[o] = static_cast<std::uint32_t>(m_ops[o].pre.size());
+    m_queue.clear();
+    m_helpful.clear();
+
+    for (auto atom : ws.get_facts())
+        if (atom < m_atom_count)
+            relax(atom, 0, NONE, 0);
+    m_gap.resize(m_numeric.size());
+    for (size_t j = 0; j < m_numeric.size(); ++j)
+    {
+        const NumericConditions::Condition& np = m_numeric[j];
+        m_gap[j] = 0;
+        if (ws.evaluates(np.cond))
+            relax(m_atom_count + static_cast<std::uint32_t>(j), 0, NONE, 0);
+        else if (np.bounded)
+            m_gap[j] = np.lower ? np.threshold - ws.get_fluent(np.fluent) : ws.get_fluent(np.fluent) - np.threshold;
+    }
+    for (auto o : m_free_ops)
+        enable(o);
+
+    size_t goals_left = m_goals.size();
+    while (!m_queue.empty() && goals_left > 0)
+    {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<>());
+        const auto [cost, p] = m_queue.back();
+        m_queue.pop_back();
+        if (m_closed[p] || cost > m_cost[p])
+            continue;
+        m_closed[p] = 1;
+        if (m_is_goal[p])
+            --goals_left;
+
+        for (auto o : m_readers[p])
+        {
+            m_pre_cost[o] = (m_mode == Mode::Max) ? std::max(m_pre_cost[o], cost) : m_pre_cost[o] + cost;
+            if (--m_missing[o] == 0)
+                enable(o);
+        }
+    }
+    if (goals_left > 0)
+        return DEAD_END;
+
+    if (m_mode == Mode::FF)
+        return extract_plan();
+
+    float h = 0;
+    for (auto g : m_goals)
+        h = (m_mode == Mode::Max) ? std::max(h, m_cost[g]) : h + m_cost[g];
+    return h;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+float RelaxedHeuristic::extract_plan()
+{
+    // Walk the best supporters back from the goals; an operator supporting
+    // several numeric propositions is applied as often as the most demanding one.
+    m_plan_reps.assign(m_ops.size(), 0);
+    m_plan_ops.clear();
+    std::fill(m_closed.begin(), m_closed.end(), 0);
+    m_stack.assign(m_goals.begin(), m_goals.end());
+    while (!m_stack.empty())
+    {
+        const std::uint32_t p = m_stack.back();
+        m_stack.pop_back();
+        if (m_closed[p])
+            continue;
+        m_closed[p] = 1;
+
+        const std::uint32_t o = m_supporter[p];
+        if (o == NONE)
+            continue; // True in the evaluated state.
+        if (m_plan_reps[o] == 0)
+        {
+            m_plan_ops.push_back(o);
+            m_stack.insert(m_stack.end(), m_ops[o].pre.begin(), m_ops[o].pre.end());
+        }
+        m_plan_reps[o] = std::max(m_plan_reps[o], m_reps[p]);
+    }
+
+    float h = 0;
+    for (auto o : m_plan_ops)
+    {
+        const Operator& op = m_ops[o];
+        h += op.cost * static_cast<float>(m_plan_reps[o]);
+
+        // Helpful: every precondition already holds in the evaluated state.
+        if (op.action != NONE &&
+            std::all_of(op.pre.begin(), op.pre.end(), [&](std::uint32_t p) { return m_supporter[p] == NONE; }))
+            m_helpful.push_back(op.action);
+    }
+    std::sort(m_helpful.begin(), m_helpful.end());
+    m_helpful.erase(std::unique(m_helpful.begin(), m_helpful.end()), m_helpful.end());
+    return h;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,106 @@
+/// @file RelaxedHeuristic.hpp
+/// Delete-relaxation heuristics h_max, h_add and h_FF with numeric repetition.
+#pragma once
+
+#include "Heuristic.hpp"
+#include "NumericConditions.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Delete-relaxation heuristics computed by a generalised Dijkstra over the
+/// ground task.
+///
+/// The relaxed task ignores delete effects and negative conditions.  Each
+/// action yields one relaxed operator for its unconditional effects and one
+/// per conditional effect (whose guard is added to the preconditions);
+/// derived predicates are zero-cost operators adding their head.
+///
+/// Numeric conditions are relaxed as intervals that effects only widen: a
+/// bound such as @c (>= (money a) 1000000) is a proposition reached by the
+/// actions moving the fluent towards it.  With an increase of @c k per
+/// application and a gap @c g in the evaluated state, an achiever costs its
+/// preconditions plus @c ceil(g/k) applications (h_add, h_FF); h_max charges
+/// @c g times the best cost-per-unit ratio of all achievers instead, which
+/// keeps it admissible.  Assignments and effects of unknown size count as one
+/// application.
+///
+/// h_FF extracts a relaxed plan from the h_add best supporters; its
+/// applicable actions are available as helpful_actions().
+/// *****************************************************************************
+class RelaxedHeuristic: public IHeuristic
+{
+public:
+
+    /// Combination of the precondition costs.
+    enum class Mode { Max, Add, FF };
+
+    RelaxedHeuristic(const SolverContext& ctx, Mode mode);
+
+    /// @copydoc IHeuristic::evaluate
+    float evaluate(const WorldState& ws) override;
+
+    /// Actions of the last relaxed plan applicable in the evaluated state,
+    /// in increasing order (FF mode only, empty otherwise).
+    const std::vector<std::uint32_t>& helpful_actions() const
+    {
+        return m_helpful;
+    }
+
+private:
+
+    /// Marker of "no operator" / "no action".
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Operator
+    {
+        std::vector<std::uint32_t> pre;               ///< Proposition preconditions.
+        std::vector<std::uint32_t> add;               ///< Atoms added.
+        std::vector<NumericConditions::Move> numeric; ///< Numeric conditions moved towards.
+        float cost = 0;                               ///< Cost of one application.
+        std::uint32_t action = NONE;                  ///< Ground action (NONE for derived predicates).
+    };
+
+    /// Register @p op, moving the numeric propositions of its @p effects.
+    void add_operator(Operator op, const std::vector<const GroundEffect*>& effects);
+
+    /// Lower the cost of proposition @p p to @p cost, supported by @p op with @p reps applications.
+    void relax(std::uint32_t p, float cost, std::uint32_t op, std::uint32_t reps);
+
+    /// All preconditions of operator @p op are reached.
+    void enable(std::uint32_t op);
+
+    /// Cost of the relaxed plan supporting the goals; fills @c m_helpful.
+    float extract_plan();
+
+private:
+
+    Mode m_mode;                                            ///< Precondition cost combination.
+    std::uint32_t m_atom_count = 0;                         ///< Atom propositions come first.
+    std::vector<Operator> m_ops;                            ///< Relaxed operators.
+    NumericConditions m_numeric;                            ///< Numeric propositions (index @c m_atom_count + i).
+    std::vector<float> m_min_ratio;                         ///< Lowest cost per unit of progress, by numeric index.
+    std::vector<std::vector<std::uint32_t>> m_readers;      ///< Operators with each proposition as precondition.
+    std::vector<std::uint32_t> m_goals;                     ///< Goal propositions (deduplicated).
+    std::vector<std::uint32_t> m_free_ops;                  ///< Operators without preconditions.
+
+    // Per-evaluation state.
+    std::vector<float> m_cost;                              ///< Cost of each proposition.
+    std::vector<std::uint32_t> m_supporter;                 ///< Best achiever of each proposition.
+    std::vector<std::uint32_t> m_reps;                      ///< Applications of the supporter needed.
+    std::vector<double> m_gap;                              ///< Distance of each numeric proposition.
+    std::vector<char> m_closed;                             ///< Proposition popped from the queue.
+    std::vector<std::uint32_t> m_missing;                   ///< Unreached preconditions per operator.
+    std::vector<float> m_pre_cost;                          ///< Combined precondition cost per operator.
+    std::vector<std::pair<float, std::uint32_t>> m_queue;   ///< Min-heap of (cost, proposition).
+    std::vector<char> m_is_goal;                            ///< Proposition is a goal.
+    std::vector<std::uint32_t> m_plan_reps;                 ///< Applications of each operator in the relaxed plan.
+    std::vector<std::uint32_t> m_plan_ops;                  ///< Operators of the relaxed plan.
+    std::vector<std::uint32_t> m_stack;                     ///< Propositions left to support.
+    std::vector<std::uint32_t> m_helpful;                   ///< Helpful actions of the last evaluation.
+};
+
+} // namespace pddl::solver
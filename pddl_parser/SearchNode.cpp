@@ -0,0 +1,19 @@
+#include "SearchNode.hpp"
+#include <algorithm>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+std::vector<std::string> reconstruct_plan(const std::vector<SearchNode>& arena,
+                                          const std::vector<GroundAction>& actions,
+                                          size_t record)
+{
+    std::vector<std::string> plan;
+    for (size_t i = record; arena[i].parent != NO_PARENT; i = arena[i].parent)
+        plan.push_back(actions[arena[i].action].name);
+    std::reverse(plan.begin(), plan.end());
+    return plan;
+}
+
+} // namespace pddl::solver
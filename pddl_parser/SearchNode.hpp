@@ -0,0 +1,51 @@
+/// @file SearchNode.hpp
+/// Search-tree records and open nodes shared by the best-first planners.
+#pragma once
+
+#include "ISolver.hpp"
+#include <string>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Search-tree record stored in the node arena.
+///
+/// Only the link to the parent record and the index of the ground action that
+/// produced this node are kept; the plan is rebuilt once by walking the parent
+/// links when the goal is popped (see reconstruct_plan).
+/// *****************************************************************************
+struct SearchNode
+{
+    size_t parent; ///< Index of the parent record in the arena (NO_PARENT for the root).
+    size_t action; ///< Index of the ground action applied to the parent.
+};
+
+/// Parent index of the root record.
+inline constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+
+/// *****************************************************************************
+/// Open node of a best-first search.
+/// *****************************************************************************
+struct Node
+{
+    float estimated_cost; ///< f = g + w * h (w = 1 for plain A*)
+    float real_cost;      ///< g = cost so far
+    float heuristic = 0;  ///< h, unweighted
+    WorldState state;     ///< State reached.
+    size_t record;        ///< Index of the matching SearchNode in the arena (grows with insertion order).
+};
+
+/// Approximate bytes of an open node holding a state shaped like @p ws.
+inline size_t node_bytes(const WorldState& ws)
+{
+    return sizeof(Node) + ws.get_words().size() * sizeof(WorldState::Word) + ws.get_fluents().size() * sizeof(double);
+}
+
+/// Rebuild the plan leading to arena record @p record by following parent links.
+std::vector<std::string> reconstruct_plan(const std::vector<SearchNode>& arena,
+                                          const std::vector<GroundAction>& actions,
+                                          size_t record);
+
+} // namespace pddl::solver
@@ -0,0 +1,141 @@
+#include "SuccessorGenerator.hpp"
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+SuccessorGenerator::SuccessorGenerator(const std::vector<GroundAction>& actions)
+    : m_facts(actions.size()), m_cursor(actions.size(), 0), m_bound(actions.size(), nullptr)
+{
+    for (size_t a = 0; a < actions.size(); ++a)
+    {
+        for (const auto& c : actions[a].preconditions)
+        {
+            FluentId fluent;
+            bool lower;
+            double threshold;
+            if (c.kind == GroundCondition::Kind::Fact)
+                m_facts[a].push_back(c.atom);
+            else if (!m_bound[a] && as_bound(c, fluent, lower, threshold))
+                m_bound[a] = &c;
+        }
+        std::sort(m_facts[a].begin(), m_facts[a].end());
+        m_facts[a].erase(std::unique(m_facts[a].begin(), m_facts[a].end()), m_facts[a].end());
+    }
+
+    std::vector<std::uint32_t> items(actions.size());
+    std::iota(items.begin(), items.end(), 0u);
+    build(items);
+
+    m_facts = {};
+    m_cursor = {};
+    m_bound = {};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::uint32_t SuccessorGenerator::build(const std::vector<std::uint32_t>& items)
+{
+    const auto head = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    // Actions without untested facts stop here, possibly in a numeric bucket.
+    std::vector<std::uint32_t> pending;
+    std::map<std::pair<FluentId, bool>, Bucket> buckets;
+    m_nodes[head].first_action = static_cast<std::uint32_t>(m_actions.size());
+    for (auto a : items)
+    {
+        FluentId fluent;
+        bool lower;
+        double threshold;
+        if (m_cursor[a] < m_facts[a].size())
+            pending.push_back(a);
+        else if (m_bound[a] && as_bound(*m_bound[a], fluent, lower, threshold))
+            buckets.try_emplace({fluent, lower}, Bucket{fluent, lower, {}}).first->second.bounds.emplace_back(threshold, a);
+        else
+            m_actions.push_back(a);
+    }
+    m_nodes[head].action_count = static_cast<std::uint32_t>(m_actions.size()) - m_nodes[head].first_action;
+
+    m_nodes[head].first_bucket = static_cast<std::uint32_t>(m_buckets.size());
+    for (auto& [key, bucket] : buckets)
+    {
+        if (bucket.lower)
+            std::stable_sort(bucket.bounds.begin(), bucket.bounds.end(),
+                             [](const auto& x, const auto& y) { return x.first < y.first; });
+        else
+            std::stable_sort(bucket.bounds.begin(), bucket.bounds.end(),
+                             [](const auto& x, const auto& y) { return x.first > y.first; });
+        m_buckets.push_back(std::move(bucket));
+    }
+    m_nodes[head].bucket_count = static_cast<std::uint32_t>(buckets.size());
+
+    // The other actions are grouped by their next fact; the groups form a chain
+    // of switch nodes linked by their "otherwise" child.
+    auto next_fact = [&](std::uint32_t a) { return m_facts[a][m_cursor[a]]; };
+    std::stable_sort(pending.begin(), pending.end(),
+                     [&](std::uint32_t x, std::uint32_t y) { return next_fact(x) < next_fact(y); });
+
+    std::uint32_t current = head;
+    for (size_t begin = 0; begin < pending.size();)
+    {
+        const AtomId atom = next_fact(pending[begin]);
+        size_t end = begin;
+        while (end < pending.size() && next_fact(pending[end]) == atom)
+            ++m_cursor[pending[end++]];
+
+        std::uint32_t node = head;
+        if (begin > 0)
+        {
+            node = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+            m_nodes[current].otherwise = node;
+        }
+        m_nodes[node].atom = atom;
+        const std::uint32_t child = build({pending.begin() + static_cast<ptrdiff_t>(begin),
+                                           pending.begin() + static_cast<ptrdiff_t>(end)});
+        m_nodes[node].if_true = child;
+
+        current = node;
+        begin = end;
+    }
+    return head;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void SuccessorGenerator::visit(std::uint32_t node, const WorldState& ws, std::vector<std::uint32_t>& out) const
+{
+    for (; node != NONE; node = m_nodes[node].otherwise)
+    {
+        const Node& n = m_nodes[node];
+        out.insert(out.end(), m_actions.begin() + n.first_action, m_actions.begin() + n.first_action + n.action_count);
+
+        for (std::uint32_t b = n.first_bucket; b < n.first_bucket + n.bucket_count; ++b)
+        {
+            const Bucket& bucket = m_buckets[b];
+            const double value = ws.get_fluent(bucket.fluent);
+            for (const auto& [threshold, action] : bucket.bounds)
+            {
+                if (bucket.lower ? threshold > value : threshold < value)
+                    break;
+                out.push_back(action);
+            }
+        }
+
+        if (n.if_true != NONE && ws.holds(n.atom))
+            visit(n.if_true, ws, out);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void SuccessorGenerator::generate(const WorldState& ws, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+    if (!m_nodes.empty())
+        visit(0, ws, out);
+    std::sort(out.begin(), out.end());
+}
+
+} // namespace pddl::solver
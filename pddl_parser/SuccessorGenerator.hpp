@@ -0,0 +1,82 @@
+/// @file SuccessorGenerator.hpp
+/// Decision tree returning the candidate applicable actions of a state.
+#pragma once
+
+#include "ISolver.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Precomputed index of ground actions by precondition.
+///
+/// The tree switches on atoms: every action is stored along the path of its
+/// positive fact preconditions (in increasing atom order), so a query only
+/// descends into the "atom true" child of a switch when the atom holds in the
+/// state, and always descends into the "don't care" child.  Below its last
+/// fact, an action with a bound on a fluent (@c f >= c, @c f <= c, ...) is
+/// stored in a bucket sorted by threshold, and a query only scans the prefix
+/// of the bucket whose thresholds the fluent value satisfies.
+///
+/// The result is a superset of the applicable actions: negative facts, other
+/// numeric conditions and strict/non-strict bound differences are not
+/// indexed, so callers still check each candidate (AStarSolver::is_applicable).
+/// *****************************************************************************
+class SuccessorGenerator
+{
+public:
+
+    explicit SuccessorGenerator(const std::vector<GroundAction>& actions);
+
+    /// Fill @p out with the indices of the candidate actions for @p ws, in
+    /// increasing order (the order of the action list, so that search stays
+    /// deterministic).
+    void generate(const WorldState& ws, std::vector<std::uint32_t>& out) const;
+
+private:
+
+    /// Marker of a missing child.
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    /// Actions bounded by the same fluent in the same direction, sorted so that
+    /// the satisfied thresholds form a prefix.
+    struct Bucket
+    {
+        FluentId fluent;                                      ///< Bounded fluent.
+        bool lower;                                           ///< @c f >= c (true) or @c f <= c (false).
+        std::vector<std::pair<double, std::uint32_t>> bounds; ///< (threshold, action), best first.
+    };
+
+    /// Switch on @c atom, plus the actions and buckets stored at this point.
+    struct Node
+    {
+        AtomId atom = 0;                ///< Switch atom (when @c if_true != NONE).
+        std::uint32_t if_true = NONE;   ///< Subtree of actions requiring @c atom.
+        std::uint32_t otherwise = NONE; ///< Subtree of the other actions.
+        std::uint32_t first_action = 0; ///< Actions with no remaining test, in @c m_actions.
+        std::uint32_t action_count = 0; ///< Number of immediate actions.
+        std::uint32_t first_bucket = 0; ///< Numeric buckets, in @c m_buckets.
+        std::uint32_t bucket_count = 0; ///< Number of numeric buckets.
+    };
+
+    /// Build the subtree holding @p items (action indices, increasing).
+    std::uint32_t build(const std::vector<std::uint32_t>& items);
+
+    /// Append the candidates of the subtree @p node to @p out.
+    void visit(std::uint32_t node, const WorldState& ws, std::vector<std::uint32_t>& out) const;
+
+private:
+
+    std::vector<Node> m_nodes;                   ///< Tree nodes, root first.
+    std::vector<std::uint32_t> m_actions;        ///< Immediate actions of the nodes.
+    std::vector<Bucket> m_buckets;               ///< Numeric buckets of the nodes.
+
+    // Build-time only.
+    std::vector<std::vector<AtomId>> m_facts;    ///< Sorted positive fact preconditions per action.
+    std::vector<size_t> m_cursor;                ///< Next untested fact per action.
+    std::vector<const GroundCondition*> m_bound; ///< Indexed numeric bound per action (may be null).
+};
+
+} // namespace pddl::solver
@@ -0,0 +1,24 @@
+#include "SymbolTable.hpp"
+
+namespace pddl::parser
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+SymbolId SymbolTable::intern(std::string const& name)
+{
+    auto [it, inserted] = m_ids.try_emplace(name, static_cast<SymbolId>(m_names.size()));
+    if (inserted)
+        m_names.push_back(name);
+    return it->second;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::optional<SymbolId> SymbolTable::find(std::string const& name) const
+{
+    auto it = m_ids.find(name);
+    if (it == m_ids.end())
+        return std::nullopt;
+    return it->second;
+}
+
+} // namespace pddl::parser
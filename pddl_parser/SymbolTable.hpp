@@ -0,0 +1,56 @@
+/// ****************************************************************************
+/// @file SymbolTable.hpp
+/// Interning table mapping PDDL identifiers to dense integer IDs.
+/// ****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pddl::parser
+{
+
+/// Dense integer ID of an interned identifier (predicate, object, function…).
+using SymbolId = std::uint32_t;
+
+/// *****************************************************************************
+/// Domain-wide table of identifiers.
+///
+/// Filled by load_domain / load_problem with predicate names, function names,
+/// types, constants and objects so that the grounded layer can work on integer
+/// IDs only.  IDs are assigned in insertion order starting at 0 and never
+/// change, so @c name(id) is a plain vector lookup.
+/// *****************************************************************************
+class SymbolTable
+{
+public:
+
+    /// Return the ID of @p name, inserting it if it is not known yet.
+    SymbolId intern(std::string const& name);
+
+    /// Return the ID of @p name, or @c std::nullopt if it was never interned.
+    std::optional<SymbolId> find(std::string const& name) const;
+
+    /// Return the identifier text of an interned ID.
+    std::string const& name(SymbolId id) const
+    {
+        return m_names[id];
+    }
+
+    /// Number of interned identifiers.
+    size_t size() const
+    {
+        return m_names.size();
+    }
+
+private:
+
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, SymbolId> m_ids;
+};
+
+} // namespace pddl::parser
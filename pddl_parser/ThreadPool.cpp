@@ -0,0 +1,110 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    m_workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back([this] { run(); });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wakeup.notify_one();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void ThreadPool::run()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty())
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& body)
+{
+    if (count == 0)
+        return;
+
+    // Shared by the caller and the helpers: a helper may only get to run after
+    // the loop is over, so the state must outlive this call.
+    struct Loop
+    {
+        std::function<void(size_t)> body;
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto loop = std::make_shared<Loop>();
+    loop->body = body;
+    loop->count = count;
+
+    auto work = [](Loop& l)
+    {
+        size_t i;
+        while ((i = l.next.fetch_add(1)) < l.count)
+        {
+            l.body(i);
+            if (l.done.fetch_add(1) + 1 == l.count)
+            {
+                std::lock_guard lock(l.mutex);
+                l.finished.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = std::min(size(), count - 1);
+    for (size_t h = 0; h < helpers; ++h)
+        submit([loop, work] { work(*loop); });
+
+    work(*loop);
+    std::unique_lock lock(loop->mutex);
+    loop->finished.wait(lock, [&] { return loop->done.load() == count; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,65 @@
+/// @file ThreadPool.hpp
+/// Fixed-size pool of worker threads shared by grounding and the solvers.
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// *****************************************************************************
+/// Fixed-size pool of worker threads consuming a FIFO task queue.
+///
+/// parallel_for() is the main entry point: it spreads the indices of a loop
+/// over the workers with dynamic scheduling, and the calling thread takes part
+/// in the loop, so it never deadlocks even when called from a worker.
+/// *****************************************************************************
+class ThreadPool
+{
+public:
+
+    /// @param threads  Number of worker threads (0 = std::thread::hardware_concurrency()).
+    explicit ThreadPool(size_t threads = 0);
+
+    /// Finish the queued tasks and join the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of worker threads.
+    size_t size() const
+    {
+        return m_workers.size();
+    }
+
+    /// Queue @p task for execution on a worker thread.
+    void submit(std::function<void()> task);
+
+    /// Call @p body(i) for every @c i in <tt>[0, count)</tt> and return once
+    /// all calls are done.  Calls run concurrently in no particular order.
+    void parallel_for(size_t count, const std::function<void(size_t)>& body);
+
+    /// Process-wide pool sized to the hardware.
+    static ThreadPool& shared();
+
+private:
+
+    /// Worker loop: pop and run tasks until stopped.
+    void run();
+
+private:
+
+    std::vector<std::thread> m_workers;        ///< Worker threads.
+    std::deque<std::function<void()>> m_tasks; ///< Pending tasks.
+    std::mutex m_mutex;                        ///< Guards @c m_tasks and @c m_stop.
+    std::condition_variable m_wakeup;          ///< Signalled when a task is queued or on stop.
+    bool m_stop = false;                       ///< Set by the destructor.
+};
+
+} // namespace pddl::solver
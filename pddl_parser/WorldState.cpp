@@ -0,0 +1,151 @@
+#include "WorldState.hpp"
+#include <algorithm>
+#include <bit>
+#include <sstream>
+#include <tuple>
+
+namespace pddl::solver
+{
+
+//---------------------------------------------------------------------------------------------------------------------
+std::vector<AtomId> WorldState::get_facts() const
+{
+    std::vector<AtomId> facts;
+    for (size_t w = 0; w < m_bits.size(); ++w)
+    {
+        for (Word bits = m_bits[w]; bits != 0; bits &= bits - 1)
+            facts.push_back(static_cast<AtomId>(w * WORD_BITS + std::countr_zero(bits)));
+    }
+    return facts;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+size_t WorldState::fact_count() const
+{
+    size_t count = 0;
+    for (auto bits : m_bits)
+        count += std::popcount(bits);
+    return count;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void WorldState::set_hash_bucket(int bucket_size)
+{
+    m_bucket_size = bucket_size;
+    m_hash = 0;
+    for (auto atom : get_facts())
+        m_hash ^= atom_key(atom);
+    for (size_t i = 0; i < m_fluents.size(); ++i)
+        m_hash ^= fluent_key(static_cast<FluentId>(i), m_fluents[i]);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/// Compare two zero-extended arrays: the longer one must be zero past the shorter one.
+template <typename T>
+static bool equal_zero_extended(std::vector<T> const& a, std::vector<T> const& b)
+{
+    const auto& [shorter, longer] = (a.size() <= b.size()) ? std::tie(a, b) : std::tie(b, a);
+    if (!std::equal(shorter.begin(), shorter.end(), longer.begin()))
+        return false;
+    return std::all_of(longer.begin() + shorter.size(), longer.end(), [](T v) { return v == T(0); });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool WorldState::operator==(WorldState const& other) const
+{
+    return equal_zero_extended(m_bits, other.m_bits) && equal_zero_extended(m_fluents, other.m_fluents);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool WorldState::evaluates(GroundCondition const& c) const
+{
+    switch (c.kind)
+    {
+        case GroundCondition::Kind::Fact:
+            return holds(c.atom);
+        case GroundCondition::Kind::NotFact:
+            return !holds(c.atom);
+        case GroundCondition::Kind::Compare:
+            break;
+    }
+
+    return compare(c.op, eval(c.lhs), eval(c.rhs));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool WorldState::is_goal_reached(const std::vector<GroundCondition>& goals) const
+{
+    for (const auto& g : goals)
+    {
+        if (!evaluates(g))
+            return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool as_bound(GroundCondition const& c, FluentId& fluent, bool& lower, double& threshold)
+{
+    if (c.kind != GroundCondition::Kind::Compare || c.lhs.is_fluent == c.rhs.is_fluent)
+        return false;
+
+    // Normalise to "fluent op constant".
+    Comparator op = c.op;
+    if (!c.lhs.is_fluent)
+    {
+        switch (op)
+        {
+            case Comparator::Lt: op = Comparator::Gt; break;
+            case Comparator::Le: op = Comparator::Ge; break;
+            case Comparator::Gt: op = Comparator::Lt; break;
+            case Comparator::Ge: op = Comparator::Le; break;
+            default: break;
+        }
+    }
+    if (op == Comparator::Eq || op == Comparator::Ne)
+        return false;
+
+    fluent = c.lhs.is_fluent ? c.lhs.fluent : c.rhs.fluent;
+    threshold = c.lhs.is_fluent ? c.rhs.value : c.lhs.value;
+    lower = (op == Comparator::Ge || op == Comparator::Gt);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::string to_string(WorldState const& ws, AtomTable const& atoms)
+{
+    std::ostringstream ss;
+    for (auto f : ws.get_facts())
+        ss << atoms.atom_name(f) << "\n";
+    const auto& fluents = ws.get_fluents();
+    for (size_t i = 0; i < fluents.size(); ++i)
+        ss << atoms.fluent_name(static_cast<FluentId>(i)) << " = " << fluents[i] << "\n";
+    return ss.str();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::string to_string(GroundCondition const& c, AtomTable const& atoms)
+{
+    switch (c.kind)
+    {
+        case GroundCondition::Kind::Fact:
+            return atoms.atom_name(c.atom);
+        case GroundCondition::Kind::NotFact:
+            return "(not " + atoms.atom_name(c.atom) + ")";
+        case GroundCondition::Kind::Compare:
+            break;
+    }
+
+    static const char* const names[] = { "=", "!=", "<", "<=", ">", ">=" };
+    auto operand = [&](NumericOperand const& o)
+    {
+        if (o.is_fluent)
+            return atoms.fluent_name(o.fluent);
+        std::ostringstream ss;
+        ss << o.value;
+        return ss.str();
+    };
+    return "(" + std::string(names[static_cast<int>(c.op)]) + " " + operand(c.lhs) + " " + operand(c.rhs) + ")";
+}
+
+} // namespace pddl::solver
@@ -0,0 +1,255 @@
+/// @file WorldState.hpp
+/// Ground conditions and the ground world state manipulated by the planners.
+#pragma once
+
+#include "AtomTable.hpp"
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pddl::solver
+{
+
+/// Comparison operator of a numeric condition such as @c (>= (money alice) 10000).
+enum class Comparator { Eq, Ne, Lt, Le, Gt, Ge };
+
+/// splitmix64 finaliser: cheap bijective 64-bit mixing used for Zobrist keys.
+inline std::uint64_t mix64(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/// Apply a comparison operator to two numeric values.
+inline bool compare(Comparator op, double lhs, double rhs)
+{
+    switch (op)
+    {
+        case Comparator::Eq:
+            return lhs == rhs;
+        case Comparator::Ne:
+            return lhs != rhs;
+        case Comparator::Lt:
+            return lhs < rhs;
+        case Comparator::Le:
+            return lhs <= rhs;
+        case Comparator::Gt:
+            return lhs > rhs;
+        case Comparator::Ge:
+            return lhs >= rhs;
+    }
+    return false;
+}
+
+/// *****************************************************************************
+/// Operand of a numeric comparison or numeric effect: either a constant or a
+/// ground fluent.
+///
+/// Plain identifiers in @c (= ?x ?y) are compiled to constants holding their
+/// symbol ID so that object equality is a numeric comparison as well.
+/// *****************************************************************************
+struct NumericOperand
+{
+    bool     is_fluent = false; ///< True: read @c fluent from the state; false: use @c value.
+    FluentId fluent    = 0;     ///< Fluent to read when @c is_fluent is true.
+    double   value     = 0.0;   ///< Constant value when @c is_fluent is false.
+};
+
+/// *****************************************************************************
+/// A ground (variable-free) condition: a positive or negative fact test, or a
+/// comparison between two numeric operands.
+/// *****************************************************************************
+struct GroundCondition
+{
+    /// Kind of test performed by the condition.
+    enum class Kind { Fact, NotFact, Compare };
+
+    Kind           kind = Kind::Fact;     ///< Kind of test.
+    AtomId         atom = 0;              ///< Tested atom for Fact / NotFact.
+    Comparator     op   = Comparator::Eq; ///< Operator for Compare.
+    NumericOperand lhs;                   ///< Left operand for Compare.
+    NumericOperand rhs;                   ///< Right operand for Compare.
+};
+
+/// Read @p c as a bound on one fluent: @c fluent >= threshold (@p lower) or
+/// @c fluent <= threshold (!@p lower), strict comparisons being widened.
+/// @return False if @p c does not compare a fluent with a constant with <, <=, > or >=.
+bool as_bound(GroundCondition const& c, FluentId& fluent, bool& lower, double& threshold);
+
+/// *****************************************************************************
+/// A set of ground atoms and numeric fluent values representing the world.
+///
+/// Atoms and fluents are referenced by the dense IDs assigned by AtomTable;
+/// use to_string() with the same table to print a state for debugging.
+///
+/// Boolean facts are stored as a packed bitset with one bit per ground atom,
+/// so test / set / clear are O(1) and equality compares whole words.  Numeric
+/// fluents are stored in a flat array indexed by FluentId (the slot assigned
+/// at grounding time), so reading @c (money alice) is a single indexed load.
+/// Both grow on demand; missing trailing entries read as false / 0.0, so states
+/// built before and after the AtomTable grew still compare equal.
+///
+/// The state also maintains an incremental Zobrist hash: every true atom and
+/// every non-zero bucketed fluent contributes a pseudo-random 64-bit key, and
+/// add / remove / set_fluent XOR the old contribution out and the new one in.
+/// Hashing a successor therefore costs one XOR per effect instead of a pass
+/// over the whole state.
+///
+/// Bucketization quantises numeric fluent values before hashing: a fluent with
+/// value @c v is snapped to @c trunc(v / bucket_size).  Two states whose
+/// fluents differ by less than the bucket size thus get the same hash, which
+/// prevents the search from exploring an exponential number of nearly-equal
+/// numeric states at the price of possibly non-optimal plans.  A bucket size
+/// of 0 (the default) hashes exact values.
+/// *****************************************************************************
+class WorldState
+{
+public:
+
+    /// Storage word of the fact bitset.
+    using Word = std::uint64_t;
+
+    /// Number of atoms per storage word.
+    static constexpr size_t WORD_BITS = 64;
+
+    WorldState() = default;
+
+    /// Create an empty state with room for @p atom_count atoms and @p fluent_count fluents.
+    WorldState(size_t atom_count, size_t fluent_count)
+        : m_bits((atom_count + WORD_BITS - 1) / WORD_BITS, 0), m_fluents(fluent_count, 0.0)
+    {
+    }
+
+    /// Check whether a ground atom is currently true.
+    bool holds(AtomId atom) const
+    {
+        const size_t w = atom / WORD_BITS;
+        return w < m_bits.size() && ((m_bits[w] >> (atom % WORD_BITS)) & 1u);
+    }
+
+    /// Add an atom to the state (no-op if already present).
+    void add(AtomId atom)
+    {
+        const size_t w = atom / WORD_BITS;
+        if (w >= m_bits.size())
+            m_bits.resize(w + 1, 0);
+        const Word bit = Word(1) << (atom % WORD_BITS);
+        if (!(m_bits[w] & bit))
+        {
+            m_bits[w] |= bit;
+            m_hash ^= atom_key(atom);
+        }
+    }
+
+    /// Remove an atom from the state (no-op if absent).
+    void remove(AtomId atom)
+    {
+        const size_t w = atom / WORD_BITS;
+        const Word bit = Word(1) << (atom % WORD_BITS);
+        if (w < m_bits.size() && (m_bits[w] & bit))
+        {
+            m_bits[w] &= ~bit;
+            m_hash ^= atom_key(atom);
+        }
+    }
+
+    /// List of the atoms currently true, in increasing ID order.
+    std::vector<AtomId> get_facts() const;
+
+    /// Number of atoms currently true.
+    size_t fact_count() const;
+
+    /// Read-only access to the packed fact bitset (bit @c i of word @c i/64 is atom @c i).
+    std::vector<Word> const& get_words() const
+    {
+        return m_bits;
+    }
+
+    /// Get a numeric fluent value (returns 0.0 if not set).
+    double get_fluent(FluentId fluent) const
+    {
+        return (fluent < m_fluents.size()) ? m_fluents[fluent] : 0.0;
+    }
+
+    /// Set a numeric fluent value.
+    void set_fluent(FluentId fluent, double val)
+    {
+        if (fluent >= m_fluents.size())
+            m_fluents.resize(fluent + 1, 0.0);
+        m_hash ^= fluent_key(fluent, m_fluents[fluent]) ^ fluent_key(fluent, val);
+        m_fluents[fluent] = val;
+    }
+
+    /// Read-only access to all fluents (entry @c i is the value of FluentId @c i).
+    std::vector<double> const& get_fluents() const
+    {
+        return m_fluents;
+    }
+
+    /// Incremental Zobrist hash of the facts and bucketed fluents.
+    std::uint64_t hash() const
+    {
+        return m_hash;
+    }
+
+    /// Bucket size used to quantise fluents in hash() (0 = exact).
+    int hash_bucket() const
+    {
+        return m_bucket_size;
+    }
+
+    /// Change the fluent bucket size and recompute hash() from scratch.
+    void set_hash_bucket(int bucket_size);
+
+    /// Equality comparison (needed for planner visited set).
+    bool operator==(WorldState const& other) const;
+
+    /// Evaluate a numeric operand (constant or fluent lookup).
+    double eval(NumericOperand const& operand) const
+    {
+        return operand.is_fluent ? get_fluent(operand.fluent) : operand.value;
+    }
+
+    /// Evaluate a single ground condition.
+    /// @return True if the condition holds in this state.
+    bool evaluates(GroundCondition const& c) const;
+
+    /// Check whether all goal conditions are satisfied.
+    bool is_goal_reached(std::vector<GroundCondition> const& goals) const;
+
+private:
+
+    /// Zobrist key of a true atom.
+    static std::uint64_t atom_key(AtomId atom)
+    {
+        return mix64(atom);
+    }
+
+    /// Zobrist key of a fluent holding @p val (0 when its bucket is 0, like an unset fluent).
+    std::uint64_t fluent_key(FluentId fluent, double val) const
+    {
+        const double bucketed =
+            (m_bucket_size > 0) ? static_cast<double>(static_cast<long long>(val / m_bucket_size)) : val;
+        if (bucketed == 0.0)
+            return 0;
+        return mix64(std::bit_cast<std::uint64_t>(bucketed) ^ mix64(~std::uint64_t(fluent)));
+    }
+
+private:
+
+    std::vector<Word> m_bits;
+    std::vector<double> m_fluents;
+    std::uint64_t m_hash = 0;
+    int m_bucket_size = 0;
+};
+
+/// Debug text of a state: its true atoms followed by its fluent values.
+std::string to_string(WorldState const& ws, AtomTable const& atoms);
+
+/// Debug text of a ground condition, e.g. "(not (has-licence alice))".
+std::string to_string(GroundCondition const& c, AtomTable const& atoms);
+
+} // namespace pddl::solver
@@ -1,18 +1,43 @@
-#include "AStarSolver.hpp"
+#include "AnytimeSolver.hpp"
+#include "AsyncSolve.hpp"
+#include "GreedySolver.hpp"
+#include "HdaStarSolver.hpp"
+#include "IdaStarSolver.hpp"
 #include "Parser.hpp"
+#include "PortfolioSolver.hpp"
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 
 namespace parser = pddl::parser;
 namespace solver = pddl::solver;
 
 static void print_usage(const char* prog)
 {
-    std::cerr << "Usage: " << prog << " -d <domain.pddl> -p <problem.pddl> [-h]\n"
+    std::cerr << "Usage: " << prog << " -d <domain.pddl> -p <problem.pddl> [-H <heuristic>] [-O <open>]\n"
+              << "       [-T <tie>] [-I <order>] [-j <threads>] [-b <nodes>] [-t <ms>] [-v]\n"
+              << "       [-w <weight> | -a <ms> | -G | -D <entries> | -P <threads> | -R <ms>] [-h]\n"
               << "Options:\n"
               << "  -d <file>   Domain PDDL file\n"
               << "  -p <file>   Problem PDDL file\n"
+              << "  -H <name>   Heuristic: goalcount (default), hmax, hadd, hff,\n"
+              << "              numeric, lmcount, lmcut, pdb\n"
+              << "  -O <name>   Open list: heap (default), buckets\n"
+              << "  -T <name>   Tie-breaking on equal f: none (default), lowh, highg\n"
+              << "  -I <name>   Order of remaining ties: lifo (default), fifo\n"
+              << "  -j <n>      Expand nodes in parallel on <n> threads (0 = shared pool)\n"
+              << "  -b <n>      Nodes popped per parallel expansion (default 1)\n"
+              << "  -t <ms>     Stop the search after <ms> milliseconds\n"
+              << "  -v          Print search progress every 1000 iterations\n"
+              << "  -w <w>      Weighted A*: f = g + w * h\n"
+              << "  -a <ms>     Anytime A* (ARA*) returning improving plans for <ms> milliseconds\n"
+              << "  -G          Greedy best-first search with preferred operators (default heuristic hff)\n"
+              << "  -D <n>      IDA* with a transposition table of <n> entries (0 = none)\n"
+              << "  -P <n>      Hash-distributed parallel A* on <n> threads (0 = all cores)\n"
+              << "  -R <ms>     Race a portfolio of planners; best plan within <ms> milliseconds\n"
+              << "              (0 = first plan found)\n"
               << "  -h          Show this help\n";
 }
 
@@ -20,6 +45,20 @@ int main(int argc, char* argv[])
 {
     const char* domain_path = nullptr;
     const char* problem_path = nullptr;
+    std::optional<solver::HeuristicKind> heuristic;
+    solver::OpenListKind open_list = solver::OpenListKind::BinaryHeap;
+    solver::TieBreaking tie_breaking = solver::TieBreaking::None;
+    solver::InsertionOrder insertion_order = solver::InsertionOrder::Lifo;
+    long expansion_threads = -1;
+    size_t expansion_batch = 1;
+    float weight = 1.0f;
+    long anytime_ms = -1;
+    bool greedy = false;
+    long ida_table = -1;
+    long hda_threads = -1;
+    long race_ms = -1;
+    long deadline_ms = -1;
+    bool show_progress = false;
 
     // Parse command line arguments
     for (int i = 1; i < argc; ++i)
@@ -28,6 +67,81 @@ int main(int argc, char* argv[])
             domain_path = argv[++i];
         else if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc)
             problem_path = argv[++i];
+        else if (std::strcmp(argv[i], "-H") == 0 && i + 1 < argc)
+        {
+            auto kind = solver::heuristic_kind_from_string(argv[++i]);
+            if (!kind)
+            {
+                std::cerr << "Unknown heuristic: " << argv[i] << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            heuristic = kind;
+        }
+        else if (std::strcmp(argv[i], "-O") == 0 && i + 1 < argc)
+        {
+            ++i;
+            if (std::strcmp(argv[i], "heap") == 0)
+                open_list = solver::OpenListKind::BinaryHeap;
+            else if (std::strcmp(argv[i], "buckets") == 0)
+                open_list = solver::OpenListKind::Buckets;
+            else
+            {
+                std::cerr << "Unknown open list: " << argv[i] << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "-T") == 0 && i + 1 < argc)
+        {
+            ++i;
+            if (std::strcmp(argv[i], "none") == 0)
+                tie_breaking = solver::TieBreaking::None;
+            else if (std::strcmp(argv[i], "lowh") == 0)
+                tie_breaking = solver::TieBreaking::LowH;
+            else if (std::strcmp(argv[i], "highg") == 0)
+                tie_breaking = solver::TieBreaking::HighG;
+            else
+            {
+                std::cerr << "Unknown tie-breaking: " << argv[i] << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "-I") == 0 && i + 1 < argc)
+        {
+            ++i;
+            if (std::strcmp(argv[i], "lifo") == 0)
+                insertion_order = solver::InsertionOrder::Lifo;
+            else if (std::strcmp(argv[i], "fifo") == 0)
+                insertion_order = solver::InsertionOrder::Fifo;
+            else
+            {
+                std::cerr << "Unknown insertion order: " << argv[i] << std::endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            expansion_threads = std::strtol(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            expansion_batch = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            deadline_ms = std::strtol(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-v") == 0)
+            show_progress = true;
+        else if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+            weight = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+            anytime_ms = std::strtol(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-G") == 0)
+            greedy = true;
+        else if (std::strcmp(argv[i], "-D") == 0 && i + 1 < argc)
+            ida_table = std::strtol(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-P") == 0 && i + 1 < argc)
+            hda_threads = std::strtol(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-R") == 0 && i + 1 < argc)
+            race_ms = std::strtol(argv[++i], nullptr, 10);
         else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
         {
             print_usage(argv[0]);
@@ -52,36 +166,127 @@ int main(int argc, char* argv[])
     try
     {
         auto domain = parser::load_domain(domain_path);
-        auto problem = parser::load_problem(problem_path);
+        auto problem = parser::load_problem(problem_path, domain.symbols);
 
         // Grounding
-        auto actions = solver::AStarSolver::instantiate_actions(domain, problem);
-        auto derived = solver::AStarSolver::instantiate_derived(domain, problem);
+        solver::AtomTable atoms(domain.symbols);
+        auto actions = solver::AStarSolver::instantiate_actions(domain, problem, atoms);
+        auto derived = solver::AStarSolver::instantiate_derived(domain, problem, atoms);
+        auto goals = solver::AStarSolver::ground_goals(problem, atoms);
 
         // Initial state
-        auto initial = solver::AStarSolver::build_initial_state(problem);
+        auto initial = solver::AStarSolver::build_initial_state(problem, atoms);
         initial = solver::AStarSolver::expand_derived(initial, derived);
+        solver::AStarSolver::prune_unreachable(initial, actions, derived);
 
         // Planning
         solver::AStarConfig config;
         config.verbose = false;
         config.fluent_bucket_size = 10;
+        config.heuristic_kind = heuristic.value_or(solver::HeuristicKind::GoalCount);
+        config.open_list = open_list;
+        config.tie_breaking = tie_breaking;
+        config.insertion_order = insertion_order;
+
+        std::unique_ptr<solver::ThreadPool> expansion_pool;
+        if (expansion_threads > 0)
+            expansion_pool = std::make_unique<solver::ThreadPool>(static_cast<size_t>(expansion_threads));
+        if (expansion_threads >= 0)
+            config.expansion_pool = expansion_pool ? expansion_pool.get() : &solver::ThreadPool::shared();
+        config.expansion_batch = expansion_batch;
+
+        std::shared_ptr<solver::ISolver> planner;
+        solver::PortfolioSolver* portfolio = nullptr;
+        if (greedy)
+        {
+            solver::GreedyConfig gbfs;
+            gbfs.fluent_bucket_size = config.fluent_bucket_size;
+            gbfs.heuristic_kind = heuristic.value_or(solver::HeuristicKind::HFF);
+            gbfs.open_list = open_list;
+            planner = std::make_unique<solver::GreedyBestFirstSolver>(gbfs);
+        }
+        else if (ida_table >= 0)
+        {
+            solver::IdaConfig ida;
+            ida.fluent_bucket_size = config.fluent_bucket_size;
+            ida.heuristic_kind = config.heuristic_kind;
+            ida.transposition_table_size = static_cast<size_t>(ida_table);
+            planner = std::make_unique<solver::IdaStarSolver>(ida);
+        }
+        else if (hda_threads >= 0)
+        {
+            solver::HdaConfig hda;
+            hda.threads = static_cast<size_t>(hda_threads);
+            hda.fluent_bucket_size = config.fluent_bucket_size;
+            hda.heuristic_kind = config.heuristic_kind;
+            planner = std::make_unique<solver::HdaStarSolver>(hda);
+        }
+        else if (race_ms >= 0)
+        {
+            // Optimal, fast-satisficing and anytime configurations.
+            solver::PortfolioConfig race;
+            race.mode = race_ms > 0 ? solver::PortfolioMode::BestPlan : solver::PortfolioMode::FirstPlan;
+            race.time_limit = std::chrono::milliseconds(race_ms);
+            auto members = std::make_unique<solver::PortfolioSolver>(race);
+
+            solver::AStarConfig pdb = config;
+            pdb.heuristic_kind = solver::HeuristicKind::Pdb;
+            solver::GreedyConfig gbfs;
+            gbfs.fluent_bucket_size = config.fluent_bucket_size;
+            solver::AnytimeConfig anytime;
+            anytime.search = config;
+            anytime.search.heuristic_kind = solver::HeuristicKind::HMax;
+
+            members->add("astar", std::make_unique<solver::AStarSolver>(config))
+                .add("astar-pdb", std::make_unique<solver::AStarSolver>(pdb))
+                .add("gbfs-hff", std::make_unique<solver::GreedyBestFirstSolver>(gbfs))
+                .add("ara-hmax", std::make_unique<solver::AnytimeAStarSolver>(anytime));
+            portfolio = members.get();
+            planner = std::move(members);
+        }
+        else if (anytime_ms >= 0)
+        {
+            solver::AnytimeConfig anytime;
+            anytime.search = config;
+            anytime.time_limit = std::chrono::milliseconds(anytime_ms);
+            planner = std::make_unique<solver::AnytimeAStarSolver>(anytime);
+        }
+        else
+            planner = std::make_unique<solver::WeightedAStarSolver>(weight, config);
+
+        solver::SolverContext ctx{ .initial = initial,
+                                   .actions = actions,
+                                   .goals = goals,
+                                   .derived = derived,
+                                   .atoms = atoms };
+        if (deadline_ms >= 0)
+            ctx.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(deadline_ms);
+        if (show_progress)
+            ctx.progress = [](const solver::SearchProgress& p)
+            {
+                std::cerr << "[progress] " << p.iterations << " iterations, " << p.open << " open, best f " << p.best_f
+                          << ", " << p.memory_bytes / 1024 << " KiB, " << p.seconds << " s\n";
+            };
+        auto result = solver::solve_async(planner, ctx).get();
 
-        solver::AStarSolver planner(config);
-        solver::SolverContext ctx{ initial, actions, problem.goal, derived };
-        auto result = planner.solve(ctx);
+        for (const auto& improvement : result.improvements)
+            std::cout << "Plan of cost " << improvement.cost << " after " << improvement.iterations
+                      << " iterations (" << improvement.seconds * 1000.0 << " ms)\n";
 
         // Result
         if (!result.success)
         {
-            std::cout << "No plan found after " << result.iterations << " iterations.\n";
+            std::cout << "No plan found after " << result.iterations << " iterations ("
+                      << solver::stop_reason_name(result.stop_reason) << ").\n";
             return EXIT_FAILURE;
         }
 
         std::cout << "Plan (" << result.plan.size() << " steps, " << result.iterations << " iterations):\n";
         for (size_t i = 0; i < result.plan.size(); ++i)
             std::cout << "  " << std::setw(3) << (i + 1) << ": " << result.plan[i] << std::endl;
-        std::cout << "Goal reached: " << (result.final_state.is_goal_reached(problem.goal) ? "YES" : "NO") << "\n";
+        std::cout << "Goal reached: " << (result.final_state.is_goal_reached(goals) ? "YES" : "NO") << "\n";
+        if (portfolio)
+            std::cout << "Found by: " << portfolio->winner() << "\n";
     }
     catch (const std::exception& ex)
     {
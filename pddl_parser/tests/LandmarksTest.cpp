@@ -0,0 +1,51 @@
+// Landmark heuristics on the millionaire task, whose goals are numeric only.
+//
+// Usage: landmarks_test <domain.pddl> <problem.pddl>
+
+#include "AStarSolver.hpp"
+#include "Heuristic.hpp"
+#include "Parser.hpp"
+#include <iostream>
+
+namespace parser = pddl::parser;
+namespace solver = pddl::solver;
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <domain.pddl> <problem.pddl>\n";
+        return 2;
+    }
+
+    auto domain = parser::load_domain(argv[1]);
+    auto problem = parser::load_problem(argv[2], domain.symbols);
+
+    solver::AtomTable atoms(domain.symbols);
+    auto actions = solver::AStarSolver::instantiate_actions(domain, problem, atoms);
+    auto derived = solver::AStarSolver::instantiate_derived(domain, problem, atoms);
+    auto goals = solver::AStarSolver::ground_goals(problem, atoms);
+    auto initial = solver::AStarSolver::build_initial_state(problem, atoms);
+    initial = solver::AStarSolver::expand_derived(initial, derived);
+    solver::AStarSolver::prune_unreachable(initial, actions, derived);
+
+    const solver::SolverContext ctx{ .initial = initial,
+                                     .actions = actions,
+                                     .goals = goals,
+                                     .derived = derived,
+                                     .atoms = atoms };
+
+    int failures = 0;
+    for (auto [kind, name] : { std::pair{ solver::HeuristicKind::LmCount, "lmcount" },
+                               std::pair{ solver::HeuristicKind::LmCut, "lmcut" } })
+    {
+        const float h = solver::make_heuristic(kind, ctx)->evaluate(initial);
+        std::cout << name << "(initial) = " << h << "\n";
+        if (!(h > 0) || h == solver::DEAD_END)
+        {
+            std::cerr << "FAIL: " << name << " must be positive and finite in the initial state\n";
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}